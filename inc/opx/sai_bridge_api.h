@@ -33,6 +33,18 @@
  *  \{
  */
 
+/**
+ * @brief Callback invoked for each bridge port of a bulk cache visit
+ *
+ * @param[in] index Index of the bridge port in the list passed to the visit
+ * @param[in] bridge_port_info Cached bridge port info, NULL if the bridge port
+ *  does not exist
+ * @param[in] ctx Context passed to the visit
+ */
+typedef void (*sai_bridge_port_cache_visit_fn) (uint_t index,
+                                                const dn_sai_bridge_port_info_t *bridge_port_info,
+                                                void *ctx);
+
 #ifdef __cplusplus
 extern "C"{
 #endif
@@ -59,6 +71,12 @@ sai_status_t sai_bridge_cache_delete (sai_object_id_t bridge_id);
 /**
  * @brief Read bridge cache info for the Bridge ID
  *
+ * The returned pointer refers to the cached entry. Callers must hold the
+ * bridge lock, under which bridges are written and deleted, for as long as
+ * they use it. The entry is read-only: lock-free readers copy it out with
+ * sai_bridge_cache_get, so changes must go through sai_bridge_cache_write.
+ * Callers that do not hold the bridge lock must use sai_bridge_cache_get.
+ *
  * @param[in] bridge_id Bridge SAI Object identifier
  * @param[inout] p_bridge_info Double Pointer to bridge info structure
  * @return SAI_STATUS_SUCCESS if successful otherwise a different
@@ -66,6 +84,35 @@ sai_status_t sai_bridge_cache_delete (sai_object_id_t bridge_id);
  */
 sai_status_t sai_bridge_cache_read (sai_object_id_t bridge_id, dn_sai_bridge_info_t **bridge_info);
 
+/**
+ * @brief Update bridge cache info through the pointer returned by
+ *        sai_bridge_cache_read
+ *
+ * If bridge_info is the cached entry, new_info is written into it under
+ * its sequence counter, as by sai_bridge_cache_write, so lock-free readers
+ * never see a partial update. Otherwise bridge_info is a copy private to
+ * the caller and is overwritten directly. Callers must hold the bridge lock.
+ *
+ * @param[inout] bridge_info Cached entry, or a private copy of bridge info
+ * @param[in] new_info Bridge info to store
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_cache_entry_update (dn_sai_bridge_info_t *bridge_info,
+                                            const dn_sai_bridge_info_t *new_info);
+
+/**
+ * @brief Get a copy of the bridge cache info for the Bridge ID
+ *
+ * Does not require the bridge lock.
+ *
+ * @param[in] bridge_id Bridge SAI Object identifier
+ * @param[out] bridge_info Bridge info structure to fill
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_cache_get (sai_object_id_t bridge_id, dn_sai_bridge_info_t *bridge_info);
+
 /**
  * @brief Write into bridge_port cache info for the Bridge port ID
  *
@@ -89,6 +136,13 @@ sai_status_t sai_bridge_port_cache_delete (sai_object_id_t bridge_port_id);
 /**
  * @brief Read bridge_port cache info for the Bridge port ID
  *
+ * The returned pointer refers to the cached entry. Callers must hold the
+ * bridge lock, under which bridge ports are written and deleted, for as
+ * long as they use it. The entry is read-only: lock-free readers copy it out
+ * with sai_bridge_port_cache_get, so changes must go through
+ * sai_bridge_port_cache_write. Callers that do not hold the bridge lock
+ * must use sai_bridge_port_cache_get.
+ *
  * @param[in] bridge_port_id Bridge port SAI Object identifier
  * @param[inout] p_bridge_port_info Double Pointer to bridge port info structure
  * @return SAI_STATUS_SUCCESS if successful otherwise a different
@@ -97,6 +151,56 @@ sai_status_t sai_bridge_port_cache_delete (sai_object_id_t bridge_port_id);
 sai_status_t sai_bridge_port_cache_read (sai_object_id_t bridge_port_id,
                                          dn_sai_bridge_port_info_t **bridge_port_info);
 
+/**
+ * @brief Update bridge port cache info through the pointer returned by
+ *        sai_bridge_port_cache_read
+ *
+ * If bridge_port_info is the cached entry, new_info is written into it
+ * through sai_bridge_port_cache_write, so lock-free readers never see a
+ * partial update. Otherwise bridge_port_info is a copy private to the
+ * caller and is overwritten directly. Callers must hold the bridge lock.
+ *
+ * @param[inout] bridge_port_info Cached entry, or a private copy of bridge
+ *  port info
+ * @param[in] new_info Bridge port info to store
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_port_cache_entry_update (dn_sai_bridge_port_info_t *bridge_port_info,
+                                                 const dn_sai_bridge_port_info_t *new_info);
+
+/**
+ * @brief Get a copy of the bridge_port cache info for the Bridge port ID
+ *
+ * Does not require the bridge lock.
+ *
+ * @param[in] bridge_port_id Bridge port SAI Object identifier
+ * @param[out] bridge_port_info Bridge port info structure to fill
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_port_cache_get (sai_object_id_t bridge_port_id,
+                                        dn_sai_bridge_port_info_t *bridge_port_info);
+
+/**
+ * @brief Visit the bridge port cache info of a list of Bridge port IDs
+ *
+ * All bridge ports are visited with the bridge port cache write lock held
+ * once, so they are seen as of a single point in time. The callback must
+ * not call back into the bridge port cache.
+ *
+ * @param[in] count Number of bridge ports in bridge_port_list
+ * @param[in] bridge_port_list List of bridge port SAI Object identifiers
+ * @param[in] visit_fn Callback invoked for each bridge port, in list order
+ * @param[in] ctx Context passed to visit_fn
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_port_cache_bulk_visit (uint_t                          count,
+                                               const sai_object_id_t          *bridge_port_list,
+                                               sai_bridge_port_cache_visit_fn  visit_fn,
+                                               void                           *ctx);
+
 /**
  * @brief Check if bridge is created
  *
@@ -149,6 +253,42 @@ sai_status_t sai_bridge_list_get(uint_t *count, sai_object_id_t *bridge_list);
  */
 sai_status_t sai_bridge_port_list_get(uint_t *count, sai_object_id_t *bridge_port_list);
 
+/**
+ * @brief Get a page of bridges in the system
+ *
+ * Bridges are returned in object id order, starting after start_after.
+ * Pass the last id of a page to get the next one. The bridge lock is not
+ * taken, so bridges created or removed while paging may or may not be
+ * seen, but no bridge present throughout is skipped or repeated.
+ *
+ * @param[in] start_after Bridge id to resume after, SAI_NULL_OBJECT_ID for the first page
+ * @param[inout] count Page size. During out it has number of bridges returned, which is
+ *  less than the page size on the last page.
+ * @param[out] bridge_list List of bridge IDs in the page
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_list_page_get(sai_object_id_t start_after, uint_t *count,
+                                      sai_object_id_t *bridge_list);
+
+/**
+ * @brief Get a page of bridge ports in the system
+ *
+ * Bridge ports are returned in object id order, starting after start_after.
+ * Pass the last id of a page to get the next one. The bridge lock is not
+ * taken, so bridge ports created or removed while paging may or may not be
+ * seen, but no bridge port present throughout is skipped or repeated.
+ *
+ * @param[in] start_after Bridge port id to resume after, SAI_NULL_OBJECT_ID for the first page
+ * @param[inout] count Page size. During out it has number of bridge ports returned, which is
+ *  less than the page size on the last page.
+ * @param[out] bridge_port_list List of bridge port IDs in the page
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_port_list_page_get(sai_object_id_t start_after, uint_t *count,
+                                           sai_object_id_t *bridge_port_list);
+
 /**
  * @brief Map the bridge port to bridge
  *
@@ -159,6 +299,21 @@ sai_status_t sai_bridge_port_list_get(uint_t *count, sai_object_id_t *bridge_por
  */
 sai_status_t sai_bridge_map_insert (sai_object_id_t bridge_id, sai_object_id_t bridge_port_id);
 
+/**
+ * @brief Map several bridge ports to their bridges at once
+ *
+ * @param[in] count Number of entries
+ * @param[in] bridge_id_list Bridge SAI Object identifier of each entry
+ * @param[in] bridge_port_list Bridge port SAI Object identifier of each entry
+ * @param[out] status_list Status of each entry
+ * @return SAI_STATUS_SUCCESS if every entry succeeded, SAI_STATUS_FAILURE
+ *  if any failed, otherwise a different error code is returned.
+ */
+sai_status_t sai_bridge_map_bulk_insert (uint32_t                count,
+                                         const sai_object_id_t  *bridge_id_list,
+                                         const sai_object_id_t  *bridge_port_list,
+                                         sai_status_t           *status_list);
+
 /**
  * @brief Remove bridge port mapping to the bridge
  *
@@ -192,9 +347,17 @@ sai_status_t sai_bridge_map_port_list_get (sai_object_id_t  bridge_id,
  */
 sai_status_t sai_bridge_map_get_port_count (sai_object_id_t  bridge_id,
                                             uint_t        *p_out_count);
-#ifdef __cplusplus
-}
-#endif
+
+/**
+ * @brief Get the bridge a bridge port is mapped to
+ *
+ * @param[in] bridge_port_id Bridge port SAI Object identifier
+ * @param[out] bridge_id Bridge the bridge port is mapped to
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_map_bridge_get (sai_object_id_t  bridge_port_id,
+                                        sai_object_id_t *bridge_id);
 
 /**
  * @brief Get the bridge mutex lock to access bridge data structure
@@ -208,6 +371,13 @@ void sai_bridge_lock(void);
  */
 void sai_bridge_unlock(void);
 
+/**
+ * @brief Check if the calling thread holds the bridge mutex lock
+ *
+ * @return true if the bridge lock is held by the caller, false otherwise
+ */
+bool sai_bridge_is_locked(void);
+
 /**
  * @brief Map the bridge port to lag
  *
@@ -353,6 +523,21 @@ sai_status_t sai_bridge_port_to_stp_port_count_get(sai_object_id_t  bridge_port_
 sai_status_t sai_tunnel_to_bridge_port_map_insert (sai_object_id_t tunnel_id,
                                                    sai_object_id_t bridge_port_id);
 
+/**
+ * @brief Map several tunnels to bridge ports at once
+ *
+ * @param[in] count Number of entries
+ * @param[in] tunnel_list Tunnel SAI Object identifier of each entry
+ * @param[in] bridge_port_list Bridge port SAI Object identifier of each entry
+ * @param[out] status_list Status of each entry
+ * @return SAI_STATUS_SUCCESS if every entry succeeded, SAI_STATUS_FAILURE
+ *  if any failed, otherwise a different error code is returned.
+ */
+sai_status_t sai_tunnel_to_bridge_port_map_bulk_insert (uint32_t                count,
+                                                        const sai_object_id_t  *tunnel_list,
+                                                        const sai_object_id_t  *bridge_port_list,
+                                                        sai_status_t           *status_list);
+
 /**
  * @brief Remove Tunnel to bridge port mapping
  *
@@ -402,6 +587,8 @@ sai_status_t sai_tunnel_to_bridge_port_get_at_index(sai_object_id_t tunnel_id,
                                                     sai_object_id_t *bridge_port);
 /**
  * @brief Update attribute value in bridge cache
+ *        The update goes through sai_bridge_cache_entry_update, so it is
+ *        safe against lock-free readers of the cached entry.
  *
  * @param[inout] bridge_info Pointer to bridge info structure
  * @param[in] attr Attribute that needs to be updated
@@ -426,6 +613,8 @@ sai_status_t sai_bridge_get_attr_value_from_bridge_info (const dn_sai_bridge_inf
 
 /**
  * @brief Update attribute value in bridge port cache
+ *        The update goes through sai_bridge_port_cache_entry_update, so it
+ *        is safe against lock-free readers of the cached entry.
  *
  * @param[inout] bridge_port_info Pointer to bridge port info structure
  * @param[in] attr Attribute that needs to be updated
@@ -449,6 +638,31 @@ sai_status_t sai_bridge_port_get_attr_value_from_bridge_port_info (const dn_sai_
                                                                    uint_t attr_count,
                                                                    sai_attribute_t *attr_list);
 
+/**
+ * @brief Get the same attributes of many bridge ports from the bridge port cache
+ *
+ * The attribute ids are resolved once for the whole list, and all bridge
+ * ports are read from a single snapshot of the cache. Results are stored
+ * per bridge port, so the attributes of bridge_port_list[i] are
+ * attr_list[i * attr_count] to attr_list[(i + 1) * attr_count - 1].
+ *
+ * @param[in] object_count Number of bridge ports in bridge_port_list
+ * @param[in] bridge_port_list List of bridge port SAI Object identifiers
+ * @param[in] attr_count Number of attribute ids in attr_id_list
+ * @param[in] attr_id_list Attribute ids to get for every bridge port
+ * @param[out] attr_list Attributes, object_count * attr_count entries
+ * @param[out] object_statuses Status of each bridge port, object_count entries
+ * @return SAI_STATUS_SUCCESS if the attributes of every bridge port were
+ *  retrieved, SAI_STATUS_FAILURE if some bridge port does not exist, otherwise
+ *  a different error code is returned.
+ */
+sai_status_t sai_bridge_port_bulk_attr_get (uint_t                 object_count,
+                                            const sai_object_id_t *bridge_port_list,
+                                            uint_t                 attr_count,
+                                            const sai_attr_id_t   *attr_id_list,
+                                            sai_attribute_t       *attr_list,
+                                            sai_status_t          *object_statuses);
+
 
 /**
  * @brief Get attached port ID from Bridge port ID
@@ -535,6 +749,14 @@ sai_status_t sai_bridge_increment_ref_count(sai_object_id_t bridge_id);
  */
 sai_status_t sai_bridge_decrement_ref_count(sai_object_id_t bridge_id);
 
+/**
+ * @brief Check if the bridge is in use
+ *
+ * @param[in] bridge_id Bridge SAI Object identifier
+ * @return true if reference count greater than zero, false otherwise
+ */
+bool sai_is_bridge_in_use(sai_object_id_t bridge_id);
+
 /**
  * @brief Increment bridge port reference count
  *
@@ -553,6 +775,14 @@ sai_status_t sai_bridge_port_increment_ref_count(sai_object_id_t bridge_port_id)
  */
 sai_status_t sai_bridge_port_decrement_ref_count(sai_object_id_t bridge_port_id);
 
+/**
+ * @brief Check if the bridge port is in use
+ *
+ * @param[in] bridge_port_id Bridge port SAI Object identifier
+ * @return true if reference count greater than zero, false otherwise
+ */
+bool sai_is_bridge_port_in_use(sai_object_id_t bridge_port_id);
+
 /**
  * @brief Check if attachment is of type port
  *
@@ -582,6 +812,23 @@ sai_status_t sai_bridge_port_vlan_to_bridge_port_map_insert (sai_object_id_t por
                                                              sai_vlan_id_t vlan_id,
                                                              sai_object_id_t bridge_port_id);
 
+/**
+ * @brief Create several mappings from port,vlan to bridge port id at once
+ *
+ * @param[in] count Number of entries
+ * @param[in] port_list SAI Port Object identifier of each entry
+ * @param[in] vlan_list VLAN identifier of each entry
+ * @param[in] bridge_port_list SAI bridge Port Object identifier of each entry
+ * @param[out] status_list Status of each entry
+ * @return SAI_STATUS_SUCCESS if every entry succeeded, SAI_STATUS_FAILURE
+ *  if any failed, otherwise a different error code is returned.
+ */
+sai_status_t sai_bridge_port_vlan_to_bridge_port_map_bulk_insert (uint32_t                count,
+                                                                  const sai_object_id_t  *port_list,
+                                                                  const sai_vlan_id_t    *vlan_list,
+                                                                  const sai_object_id_t  *bridge_port_list,
+                                                                  sai_status_t           *status_list);
+
 /**
  * @brief Remove mapping from port,vlan to bridge port id
  *
@@ -596,6 +843,11 @@ sai_status_t sai_bridge_port_vlan_to_bridge_port_map_remove (sai_object_id_t por
 /**
  * @brief Check if already a bridge port exists for port vlan combination
  *
+ * Looks up the port vlan to bridge port map, which the bridge port
+ * create and remove paths maintain through
+ * sai_bridge_port_vlan_to_bridge_port_map_insert and
+ * sai_bridge_port_vlan_to_bridge_port_map_remove.
+ *
  * @param[in] port_id SAI Port Object identifier
  * @param[in] vlan_id VLAN identifier
  * @return true if already a bridge port exists, false otherwise
@@ -613,6 +865,43 @@ bool sai_bridge_is_bridge_sub_port_duplicate(sai_object_id_t port_id, sai_vlan_i
 bool sai_bridge_is_bridge_connected_to_tunnel(sai_object_id_t bridge_id,
                                               sai_object_id_t tunnel_id);
 
+/**
+ * @brief Get the list of bridge ports attached to a LAG
+ *
+ * @param[in] lag_id SAI LAG Object identifier
+ * @param[inout] count Size of bridge_port_list. During out it has number of bridge ports.
+ * @param[out] bridge_port_list List of bridge ports attached to the LAG
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_port_list_get_by_lag (sai_object_id_t  lag_id,
+                                              uint_t          *count,
+                                              sai_object_id_t *bridge_port_list);
+
+/**
+ * @brief Get the list of bridge ports of a type
+ *
+ * @param[in] bridge_port_type Bridge port type
+ * @param[inout] count Size of bridge_port_list. During out it has number of bridge ports.
+ * @param[out] bridge_port_list List of bridge ports of the type
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_port_list_get_by_type (sai_bridge_port_type_t  bridge_port_type,
+                                               uint_t                 *count,
+                                               sai_object_id_t        *bridge_port_list);
+
+/**
+ * @brief Get the number of bridge ports of a type
+ *
+ * @param[in] bridge_port_type Bridge port type
+ * @param[out] p_out_count Number of bridge ports of the type
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_bridge_port_count_get_by_type (sai_bridge_port_type_t  bridge_port_type,
+                                                uint_t                 *p_out_count);
+
 /**
  * @brief Check if bridge port attached to a loag
  *
@@ -905,21 +1194,31 @@ static inline void *sai_bridge_port_get_sub_port_hw_info(dn_sai_bridge_port_info
 
 /**
  * @brief Set hardware info in bridge port info
+ *        The update goes through sai_bridge_port_cache_entry_update, so it
+ *        is safe against lock-free readers of the cached entry.
  *
  * @param[inout] bridge_port_info Pointer to bridge port info
  * @param[inout] ptr Pointer which needs to be saved in hardware info
- * @return A pointer to hardware info
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
  */
 static inline sai_status_t sai_bridge_port_set_sub_port_hw_info(dn_sai_bridge_port_info_t
                                                                  *bridge_port_info, void *ptr)
 {
+    dn_sai_bridge_port_info_t new_info;
+
     if(bridge_port_info == NULL) {
         return SAI_STATUS_INVALID_PARAMETER;
     }
-    bridge_port_info->attachment.sub_port.hw_info = ptr;
-    return SAI_STATUS_SUCCESS;
+    new_info = *bridge_port_info;
+    new_info.attachment.sub_port.hw_info = ptr;
+    return sai_bridge_port_cache_entry_update(bridge_port_info, &new_info);
 }
 
+#ifdef __cplusplus
+}
+#endif
+
 /**
  * \}
  */
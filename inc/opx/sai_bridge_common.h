@@ -59,9 +59,6 @@ typedef struct _dn_sai_bridge_info_t {
     /* Switch Id that the bridge is part of */
     sai_object_id_t    switch_obj_id;
 
-    /* Number of objects that reference this bridge */
-    uint_t             ref_count;
-
     /* A void pointer which contains NPU specific hardware info */
     void              *hw_info;
 
@@ -130,34 +127,23 @@ typedef struct _dn_sai_bridge_tunnel_port_t {
  */
 typedef struct _dn_sai_bridge_port_info_t{
 
+    /*
+     * Fields read on every lookup come first so that they share the cache
+     * line of the bridge port cache entry.
+     */
     sai_bridge_port_type_t               bridge_port_type;
 
-    /* Unique Bridge port object ID per Bridge port */
-    sai_object_id_t                      bridge_port_id;
-
-    /* Unique Bridge port object ID per Bridge port */
-    sai_object_id_t                      bridge_id;
-
-    /* Unique Bridge port object ID per Bridge port */
-    sai_bridge_port_fdb_learning_mode_t  fdb_learn_mode;
-
-    /* Max learnt FDB address on the FDB port */
-    sai_uint32_t                         max_learned_address;
-
-    /* Packet action on learn limit violation */
-    sai_packet_action_t                  learn_limit_violation_action;
-
     /* Admin state of the bridge port */
     bool                                 admin_state;
 
     /* If ingress filtering is set drop frames with unknown VLANs*/
     bool                                 ingress_filtering;
 
-    /* Switch Id that the bridge port is part of */
-    sai_object_id_t                      switch_obj_id;
+    /* Unique Bridge port object ID per Bridge port */
+    sai_object_id_t                      bridge_port_id;
 
-    /* Number of objects that reference this bridge port */
-    uint_t                               ref_count;
+    /* Unique Bridge port object ID per Bridge port */
+    sai_object_id_t                      bridge_id;
 
     union {
         /* Attachment type port */
@@ -174,6 +160,18 @@ typedef struct _dn_sai_bridge_port_info_t{
 
     }attachment;
 
+    /* Unique Bridge port object ID per Bridge port */
+    sai_bridge_port_fdb_learning_mode_t  fdb_learn_mode;
+
+    /* Max learnt FDB address on the FDB port */
+    sai_uint32_t                         max_learned_address;
+
+    /* Packet action on learn limit violation */
+    sai_packet_action_t                  learn_limit_violation_action;
+
+    /* Switch Id that the bridge port is part of */
+    sai_object_id_t                      switch_obj_id;
+
 }dn_sai_bridge_port_info_t;
 
 /*Bridge port event: List of events from a bridge port*/
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2017 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_epoch.h
+ *
+ * @brief Epoch based memory reclamation shared by the lock-free readers
+ *        of the SAI common code (sai_map_utl.cpp, sai_bridge_db.cpp).
+ *
+ * Readers bracket their accesses with sai_epoch_read_lock() and
+ * sai_epoch_read_unlock(). Writers that unlink an object a reader may
+ * still be looking at retire it onto a retire list instead of freeing it,
+ * and sai_epoch_reclaim() frees it once every reader that could hold a
+ * reference to it has left its read-side section. Read-side sections nest,
+ * and all users share one epoch and one set of reader slots.
+ *
+ * C++ only, not installed.
+ */
+
+#ifndef _SAI_EPOCH_H_
+#define _SAI_EPOCH_H_
+
+#ifdef __cplusplus
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Read-side registration. Each reader thread owns one slot and publishes
+ * the global epoch it observed on entry, or 0 when it is not reading.
+ * Threads beyond SAI_EPOCH_MAX_READERS cannot read lock, and must fall back
+ * to the writer lock of the structure they read.
+ */
+#define SAI_EPOCH_MAX_READERS  (256)
+
+struct alignas(64) sai_epoch_reader_t {
+    std::atomic<uint64_t> epoch;
+    std::atomic<bool>     in_use;
+};
+
+struct sai_epoch_reader_reg_t {
+    sai_epoch_reader_t *reader;
+    uint32_t            depth;
+    bool                registered;
+
+    ~sai_epoch_reader_reg_t ();
+};
+
+/* Header of every object that is reclaimed through the epoch scheme */
+struct sai_epoch_obj_t {
+    sai_epoch_obj_t      *next;
+    uint64_t              epoch;
+
+    /* Start of the allocation to free */
+    void                 *mem;
+
+    /* References held outside of a read-side section. Freed only at 0. */
+    std::atomic<uint32_t> pins;
+};
+
+/* Objects retired by a writer. Only accessed with the writer lock held. */
+struct sai_epoch_retire_list_t {
+    sai_epoch_obj_t *head;
+    uint32_t         count;
+};
+
+extern sai_epoch_reader_t                  g_sai_epoch_readers [SAI_EPOCH_MAX_READERS];
+extern std::atomic<uint64_t>               g_sai_epoch;
+extern thread_local sai_epoch_reader_reg_t t_sai_epoch_reader;
+
+/**
+ * @brief Assign a reader slot to the calling thread, on its first read
+ *
+ * @return Reader slot of the thread, NULL if all slots are taken
+ */
+sai_epoch_reader_t *sai_epoch_reader_register (void);
+
+/**
+ * @brief Retire an unlinked object
+ *
+ * @param[inout] list Retire list of the writer
+ * @param[in] obj Reclamation header of the object
+ * @param[in] mem Start of the allocation holding the object
+ */
+void sai_epoch_retire (sai_epoch_retire_list_t *list, sai_epoch_obj_t *obj, void *mem);
+
+/**
+ * @brief Advance the epoch and free the objects of a retire list that no
+ *        reader can still reference
+ *
+ * @param[inout] list Retire list of the writer
+ */
+void sai_epoch_reclaim (sai_epoch_retire_list_t *list);
+
+static inline sai_epoch_reader_t *sai_epoch_reader_get (void)
+{
+    if (t_sai_epoch_reader.registered) {
+        return t_sai_epoch_reader.reader;
+    }
+
+    return sai_epoch_reader_register ();
+}
+
+/* Reader slot index of the thread, or SAI_EPOCH_MAX_READERS if it has none */
+static inline uint32_t sai_epoch_reader_index (void)
+{
+    sai_epoch_reader_t *reader = sai_epoch_reader_get ();
+
+    if (reader == NULL) {
+        return SAI_EPOCH_MAX_READERS;
+    }
+
+    return (uint32_t) (reader - g_sai_epoch_readers);
+}
+
+/* Returns false if the thread could not be registered as a reader */
+static inline bool sai_epoch_read_lock (void)
+{
+    sai_epoch_reader_t *reader = sai_epoch_reader_get ();
+
+    if (reader == NULL) {
+        return false;
+    }
+
+    if (t_sai_epoch_reader.depth++ == 0) {
+        reader->epoch.store (g_sai_epoch.load (std::memory_order_acquire),
+                             std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+    }
+
+    return true;
+}
+
+static inline void sai_epoch_read_unlock (void)
+{
+    if (--t_sai_epoch_reader.depth == 0) {
+        t_sai_epoch_reader.reader->epoch.store (0, std::memory_order_release);
+    }
+}
+
+#endif /* __cplusplus */
+
+#endif /* _SAI_EPOCH_H_ */
@@ -34,7 +34,8 @@
 */
 sai_status_t sai_init_fdb_tree(void);
 
-/** SAI FDB API - Get FDB entry Node from cache
+/** SAI FDB API - Get FDB entry Node from cache. Called with the shard lock of the
+                  VLAN of the entry held.
       \param[in] fdb_entry FDB entry for which node to be get from cache
       \return Success: A valid pointer to FDB entry node
                     Failure: NULL
@@ -42,7 +43,8 @@ sai_status_t sai_init_fdb_tree(void);
 sai_fdb_entry_node_t* sai_get_fdb_entry_node(const sai_fdb_entry_t *fdb_entry);
 
 
-/** SAI FDB API - Create and insert FDB entry Node to cache
+/** SAI FDB API - Create and insert FDB entry Node to cache. Called with the shard
+                  lock of the VLAN of the entry held.
       \param[in] fdb_entry FDB entry to be cached
       \param[in] fdb_entry_node_data Data to be cached for the FDB entry node
       \return Success: SAI_STATUS_SUCCESS
@@ -51,7 +53,40 @@ sai_fdb_entry_node_t* sai_get_fdb_entry_node(const sai_fdb_entry_t *fdb_entry);
 sai_status_t sai_insert_fdb_entry_node(const sai_fdb_entry_t *fdb_entry,
                                        sai_fdb_entry_node_t *fdb_entry_node_data);
 
-/** SAI FDB API - Update existing FDB entry node
+/** SAI FDB API - Create and insert a burst of FDB entry nodes to cache. Called
+                  with the FDB lock held, or the shard lock if all the entries are in
+                  one VLAN, so that the whole burst is cached under one lock
+                  acquisition. Index and node memory is sized for the burst up front.
+      \param[in] count Number of entries
+      \param[in] fdb_entries FDB entries to be cached
+      \param[in] fdb_entry_node_data Data to be cached for each FDB entry node
+      \param[out] updates How each entry changed the cache. Can be NULL
+      \param[out] object_statuses Status of each entry, SAI_STATUS_ITEM_ALREADY_EXISTS
+                  if it was already cached with the same data
+      \return Success: SAI_STATUS_SUCCESS, all entries cached
+                    Failure: SAI_STATUS_INVALID_PARAMETER, SAI_STATUS_FAILURE if
+                    any entry could not be cached
+*/
+sai_status_t sai_insert_fdb_entry_nodes(uint_t count, const sai_fdb_entry_t *fdb_entries,
+                                        const sai_fdb_entry_node_t *fdb_entry_node_data,
+                                        sai_fdb_entry_update_t *updates,
+                                        sai_status_t *object_statuses);
+
+/** SAI FDB API - Remove a burst of FDB entry nodes from cache. Called with the
+                  FDB lock held, or the shard lock if all the entries are in one VLAN.
+      \param[in] count Number of entries
+      \param[in] fdb_entries FDB entries to be removed
+      \param[out] object_statuses Status of each entry, SAI_STATUS_ADDR_NOT_FOUND
+                  if it was not cached
+      \return Success: SAI_STATUS_SUCCESS, all entries removed
+                    Failure: SAI_STATUS_INVALID_PARAMETER, SAI_STATUS_FAILURE if
+                    any entry was not cached
+*/
+sai_status_t sai_remove_fdb_entry_nodes(uint_t count, const sai_fdb_entry_t *fdb_entries,
+                                        sai_status_t *object_statuses);
+
+/** SAI FDB API - Update existing FDB entry node. Called with the shard lock of the
+                  VLAN of the entry held.
       \param[inout] fdb_entry FDB entry node to be updated
       \param[in] sai_attribute_t attribute that needs to be updated
       \return Success: SAI_STATUS_SUCCESS
@@ -67,7 +102,8 @@ void sai_update_fdb_entry_node (sai_fdb_entry_node_t *fdb_entry_node,
 */
 sai_status_t sai_is_valid_fdb_attribute_val(const sai_attribute_t *fdb_attr);
 
-/** SAI FDB API - Get port id from fdb entry
+/** SAI FDB API - Get port id from fdb entry. Called with the shard lock of the VLAN
+                  of the entry held.
       \param[in] fdb_entry FDB entry for which port is required
       \param[out] port_id Port id on which entry is installed
       \return Success: SAI_STATUS_SUCCESS
@@ -76,7 +112,11 @@ sai_status_t sai_is_valid_fdb_attribute_val(const sai_attribute_t *fdb_attr);
 sai_status_t sai_fdb_get_port_from_cache(const sai_fdb_entry_t *fdb_entry,
                                          sai_object_id_t *port_id);
 
-/** SAI FDB API - Lock FDB for access
+/** SAI FDB API - Lock FDB for access. Locks the shards of all VLANs, so it is only
+                  for whole-table operations, such as flushes not limited to one VLAN
+                  and ordered walks. Accesses to the entries of one VLAN, including
+                  learning, inserting, updating and removing them, take
+                  sai_fdb_shard_lock instead. Must not be called with a shard lock held.
 */
 void sai_fdb_lock(void);
 
@@ -84,16 +124,30 @@ void sai_fdb_lock(void);
 */
 void sai_fdb_unlock(void);
 
+/** SAI FDB API - Lock the FDB shard of a VLAN for access to the entries of that
+                  VLAN only. Accesses to VLANs of different shards do not contend.
+                  Must not be called with another shard lock or the FDB lock held.
+    \param[in] vlan_id VLAN identifier
+*/
+void sai_fdb_shard_lock(sai_vlan_id_t vlan_id);
+
+/** SAI FDB API - Unlock the FDB shard of a VLAN after access
+    \param[in] vlan_id VLAN identifier
+*/
+void sai_fdb_shard_unlock(sai_vlan_id_t vlan_id);
+
 
 /** SAI FDB API - Write a registered FDB entry into cache so that an event
-                  like insert, delete or move could trigger the notification to subscriber
+                  like insert, delete or move could trigger the notification to subscriber.
+                  Called with the shard lock of the VLAN of the entry held.
     \param[in] fdb_entry FDB Entry to register
     \return Success: SAI_STATUS_SUCCESS
             Failure: Appropriate error code will be returned
 */
 sai_status_t sai_fdb_write_registered_entry_into_cache (const sai_fdb_entry_t *fdb_entry);
 
-/** SAI FDB API - Remove a registered FDB entry
+/** SAI FDB API - Remove a registered FDB entry. Called with the shard lock of the
+                  VLAN of the entry held.
     \param[in] fdb_entry FDB Entry to register
     \return Success: SAI_STATUS_SUCCESS
             Failure: Appropriate error code will be returned
@@ -116,10 +170,45 @@ typedef sai_status_t (*sai_fdb_internal_callback_fn)(uint_t num_notification,
 void sai_fdb_internal_callback_cache_update (sai_fdb_internal_callback_fn
                                                  fdb_callback);
 
-/** SAI FDB API - Send internal notifications to the subscriber
+/** SAI FDB API - Send internal notifications to the subscriber. Must only be
+                  called from one thread at a time. Besides after FDB events, the
+                  notifier must call it once the timeout returned by
+                  sai_fdb_notification_next_release_get expires, to send the final
+                  state of dampened entries.
 */
 void sai_fdb_send_internal_notifications(void);
 
+/** SAI FDB API - Configure MAC move dampening of internal notifications. Once a
+                  registered entry moves more than move_threshold times within
+                  window_ms, its notifications are held until the end of the window
+                  and then sent as one notification of the final state, flagged as
+                  flapping. The final state is sent by the first call to
+                  sai_fdb_send_internal_notifications after the end of the window,
+                  see sai_fdb_notification_next_release_get. Called with the FDB
+                  lock held.
+    \param[in] window_ms Dampening window in milliseconds, 0 disables dampening
+    \param[in] move_threshold Number of moves allowed within a window
+*/
+void sai_fdb_move_dampening_set (uint_t window_ms, uint_t move_threshold);
+
+/** SAI FDB API - Get the time left until the earliest dampened registered entry is
+                  due to have its final state sent. A dampened entry that stops
+                  moving produces no further FDB event, so the notifier must wake and
+                  call sai_fdb_send_internal_notifications once this timeout expires,
+                  and must get it again after each FDB event it handles, as a newly
+                  dampened entry can be due earlier. Does not need any FDB lock held.
+    \param[out] timeout_ms Milliseconds until the earliest release, 0 if one is due
+    \return true if an entry is dampened, false if none is and the notifier only
+            needs to wake on FDB events
+*/
+bool sai_fdb_notification_next_release_get (uint_t *timeout_ms);
+
+/** SAI FDB API - Get the internal notification queue statistics. Called with the
+                  FDB lock held.
+    \param[out] stats Notification queue statistics
+*/
+void sai_fdb_notification_stats_get (sai_fdb_notification_stats_t *stats);
+
 /** SAI FDB API - Check if there are any pending notifications to be sent
     \return Success: true
             Failure: false
@@ -127,6 +216,61 @@ void sai_fdb_send_internal_notifications(void);
 bool sai_fdb_is_notifications_pending (void);
 
 
+/** SAI FDB API - Learn limit callback function pointer declaration. Called when the
+                  number of dynamic entries on a port or in a VLAN goes above its
+                  learn limit, or back within it. Called with the lock of the shard
+                  of the entry held, or from the learn limit setters, so can be called
+                  concurrently for entries in VLANs of different shards.
+    \param[in] port_id Port or LAG identifier, SAI_NULL_OBJECT_ID for a VLAN limit
+    \param[in] vlan_id VLAN identifier, 0 for a port limit
+    \param[in] learn_count Number of dynamic entries
+    \param[in] limit_exceeded true if learn_count went above the limit, false if it
+                went back within it
+*/
+typedef void (*sai_fdb_learn_limit_callback_fn)(sai_object_id_t port_id,
+                                                sai_vlan_id_t vlan_id,
+                                                uint_t learn_count,
+                                                bool limit_exceeded);
+
+/** SAI FDB API - Register learn limit callback function
+    \param[in] learn_limit_callback Function pointer to callback function
+*/
+void sai_fdb_learn_limit_callback_cache_update (sai_fdb_learn_limit_callback_fn
+                                                    learn_limit_callback);
+
+/** SAI FDB API - Set the learn limit of a port. Does not need any FDB lock held.
+    \param[in] port_id Port or LAG identifier
+    \param[in] learn_limit Maximum number of dynamic entries, SAI_FDB_LEARN_LIMIT_DISABLE
+                for no limit
+    \return Success: SAI_STATUS_SUCCESS
+            Failure: SAI_STATUS_NO_MEMORY, SAI_STATUS_UNINITIALIZED
+*/
+sai_status_t sai_fdb_port_learn_limit_set (sai_object_id_t port_id, uint_t learn_limit);
+
+/** SAI FDB API - Set the learn limit of a VLAN. Called with the shard lock of the
+                  VLAN held.
+    \param[in] vlan_id VLAN identifier
+    \param[in] learn_limit Maximum number of dynamic entries, SAI_FDB_LEARN_LIMIT_DISABLE
+                for no limit
+    \return Success: SAI_STATUS_SUCCESS
+            Failure: SAI_STATUS_INVALID_PARAMETER
+*/
+sai_status_t sai_fdb_vlan_learn_limit_set (sai_vlan_id_t vlan_id, uint_t learn_limit);
+
+/** SAI FDB API - Get the number of dynamic entries learnt on a port. Does not need
+                  any FDB lock held.
+    \param[in] port_id Port or LAG identifier
+    \return Number of dynamic entries
+*/
+uint_t sai_fdb_port_learn_count_get (sai_object_id_t port_id);
+
+/** SAI FDB API - Get the number of dynamic entries learnt in a VLAN. Called with
+                  the shard lock of the VLAN held.
+    \param[in] vlan_id VLAN identifier
+    \return Number of dynamic entries
+*/
+uint_t sai_fdb_vlan_learn_count_get (sai_vlan_id_t vlan_id);
+
 /** SAI FDB API - Get FDB entry type for flush
       \param[in] flush_entry_type The type of entry that needs to be flushed
       \return: One of entry types in sai_fdb_entry_type_t
@@ -149,19 +293,39 @@ static inline sai_fdb_entry_type_t sai_get_sai_fdb_entry_type_for_flush(sai_fdb_
 typedef void (*sai_fdb_npu_event_notification_fn) (uint_t num_notification,
                                                    sai_fdb_event_data_t *event_data);
 
-/** SAI FDB API - Remove FDB entry node from cache
+/** SAI FDB API - Remove FDB entry node from cache. Called with the shard lock of
+                  the VLAN of the entry held.
       \param[in] fdb_entry_node Remove FDB entry node from cache
 
 */
 void sai_remove_fdb_entry_node (sai_fdb_entry_node_t *fdb_entry_node);
 
-/** SAI FDB API - Get the next FDB entry node from cache
+/** SAI FDB API - Remove all FDB entry nodes matching a port, VLAN and entry type
+                  from cache in one pass. Registered entries among them are queued
+                  for notification together. Must be called with the FDB lock held, or
+                  the shard lock of the VLAN if vlan_id is set.
+      \param[in] port_id Port or LAG identifier. SAI_NULL_OBJECT_ID if port match is not used
+      \param[in] vlan_id VLAN Identifier. 0 if vlan match is not used
+      \param[in] delete_all Flush all entry types
+      \param[in] flush_type Specific entry type that needs to be flushed
+      \param[out] flushed_count Number of entry nodes removed. Can be NULL
+      \return Success: SAI_STATUS_SUCCESS
+              Failure: SAI_STATUS_INVALID_PARAMETER
+*/
+sai_status_t sai_fdb_flush_entry_nodes (sai_object_id_t port_id, sai_vlan_id_t vlan_id,
+                                        bool delete_all,
+                                        sai_fdb_flush_entry_type_t flush_type,
+                                        uint_t *flushed_count);
+
+/** SAI FDB API - Get the next FDB entry node from cache, in key order across all
+                  shards. Called with the FDB lock held.
       \param[in] fdb_key Key of the current FDB entry node
 
 */
 sai_fdb_entry_node_t *sai_get_next_fdb_entry_node (sai_fdb_entry_key_t *fdb_key);
 
-/** SAI FDB API - Get the next FDB registered node from cache
+/** SAI FDB API - Get the next FDB registered node from cache, in key order across
+                  all shards. Called with the FDB lock held.
       \param[in] fdb_key Key of the current FDB registered node
 
 */
@@ -35,8 +35,17 @@
 #include "saifdb.h"
 #include "std_radix.h"
 #include "std_radical.h"
+#include "std_llist.h"
+#include "std_rbtree.h"
+#include "std_mutex_lock.h"
+#include "sai_vlan_common.h"
 #include "sai_event_log.h"
 
+#define SAI_FDB_MAX_NOTIFICATION_NODES 50
+#define SAI_FDB_NOTIFICATION_RING_SIZE 1024
+#define SAI_FDB_REGISTERED_FILTER_SIZE 65536
+#define SAI_FDB_NUM_SHARDS 16
+
 /** FDB Entry key: Key used to save FDB entry in cache*/
 typedef struct _sai_fdb_entry_key_t {
     /*vlan_id: represents the VLAN identifier of the entry*/
@@ -45,12 +54,53 @@ typedef struct _sai_fdb_entry_key_t {
     sai_mac_t mac_address;
 }sai_fdb_entry_key_t;
 
+/** FDB Port Learn Node: Dynamic FDB entries learnt on a port or LAG across all shards*/
+typedef struct _sai_fdb_port_learn_node_t {
+    /*port_id: Port or LAG identifier, key of the FDB port learn tree*/
+    sai_object_id_t port_id;
+    /*learn_state: Number of dynamic FDB entry nodes on the port in the low 32 bits and
+      learn limit of the port in the high 32 bits, updated together atomically*/
+    uint64_t        learn_state;
+    /*ref_count: Number of FDB port nodes referring to the learn node*/
+    uint_t          ref_count;
+} sai_fdb_port_learn_node_t;
+
+/** FDB Port Node: FDB entries of a shard learnt on a port or LAG*/
+typedef struct _sai_fdb_port_node_t {
+    /*port_id: Port or LAG identifier, key of the FDB port tree*/
+    sai_object_id_t port_id;
+    /*fdb_list: FDB entry nodes on the port, linked through their port_link*/
+    std_dll_head    fdb_list;
+    /*fdb_count: Number of FDB entry nodes on the port*/
+    uint_t          fdb_count;
+    /*learn_node: Learn node of the port, shared by the port nodes of all shards*/
+    sai_fdb_port_learn_node_t *learn_node;
+} sai_fdb_port_node_t;
+
+/** FDB VLAN Node: FDB entries learnt in a VLAN*/
+typedef struct _sai_fdb_vlan_node_t {
+    /*fdb_list: FDB entry nodes in the VLAN, linked through their vlan_link*/
+    std_dll_head    fdb_list;
+    /*fdb_count: Number of FDB entry nodes in the VLAN*/
+    uint_t          fdb_count;
+    /*learn_count: Number of dynamic FDB entry nodes in the VLAN*/
+    uint_t          learn_count;
+    /*learn_limit: Learn limit of the VLAN, SAI_FDB_LEARN_LIMIT_DISABLE if none*/
+    uint_t          learn_limit;
+} sai_fdb_vlan_node_t;
+
 /** FDB Entry Node: The full FDB node structure*/
 typedef struct _sai_fdb_entry_node_t {
     /*fdb_rt_head: Radix tree head*/
     std_rt_head fdb_rt_head;
     /*fdb_key: Key for the FDB node*/
     sai_fdb_entry_key_t fdb_key;
+    /*port_link: Link in the FDB entry list of the port node*/
+    std_dll port_link;
+    /*vlan_link: Link in the FDB entry list of the VLAN node*/
+    std_dll vlan_link;
+    /*port_node: Port node the entry is linked to*/
+    sai_fdb_port_node_t *port_node;
     /*port_id: Port on which FDB entry is learnt*/
     sai_object_id_t      port_id;
     /*entry_type: Type of the entry either static or dynamic*/
@@ -63,6 +113,18 @@ typedef struct _sai_fdb_entry_node_t {
     bool is_pending_entry;
 }sai_fdb_entry_node_t;
 
+/** FDB Entry Update: How inserting an entry changed the FDB cache*/
+typedef enum _sai_fdb_entry_update_t {
+    /*Entry already cached with the same port, type and action, or not inserted*/
+    SAI_FDB_ENTRY_UPDATE_NONE,
+    /*Entry added to the cache*/
+    SAI_FDB_ENTRY_UPDATE_NEW,
+    /*Cached entry moved to another port*/
+    SAI_FDB_ENTRY_UPDATE_MOVED,
+    /*Cached entry type or action changed, port unchanged*/
+    SAI_FDB_ENTRY_UPDATE_MODIFIED,
+} sai_fdb_entry_update_t;
+
 /** FDB Registered Node: The full FDB registered node structure*/
 typedef struct _sai_fdb_registered_node_t {
     /*fdb_radical_head: Radical tree head*/
@@ -73,8 +135,24 @@ typedef struct _sai_fdb_registered_node_t {
     sai_object_id_t     port_id;
     /*node_in_cl: If the node is currently in the changelist*/
     bool                node_in_cl;
+    /*node_in_ring: If a notification of the node was queued on the ring at ring_seq*/
+    bool                node_in_ring;
+    /*ring_seq: Ring index of the last notification of the node queued on the ring*/
+    uint_t              ring_seq;
     /*fdb_event: FDB event associated with the node*/
     sai_fdb_event_t     fdb_event;
+    /*is_flapping: If the pending notification reports a dampened entry*/
+    bool                is_flapping;
+    /*is_dampened: If notifications for the node are held until release_time_ms*/
+    bool                is_dampened;
+    /*move_count: Number of moves in the current dampening window*/
+    uint_t              move_count;
+    /*window_start_ms: Start of the current dampening window*/
+    uint64_t            window_start_ms;
+    /*release_time_ms: Time the held notification is sent at, if dampened*/
+    uint64_t            release_time_ms;
+    /*dampened_link: Link in the list of dampened nodes*/
+    std_dll             dampened_link;
 } sai_fdb_registered_node_t;
 
 /** FDB Internal notification data: Data passed in notifications internal to other SAI modules*/
@@ -85,8 +163,57 @@ typedef struct _sai_fdb_internal_notification_data_t {
     sai_object_id_t     port_id;
     /*fdb_event: FDB event associated with the data*/
     sai_fdb_event_t     fdb_event;
+    /*is_flapping: Entry moved more than the dampening threshold within the window.
+      The event and port are the last ones seen during the window*/
+    bool                is_flapping;
 } sai_fdb_internal_notification_data_t;
 
+/** FDB Notification ring: Preallocated single producer, single consumer queue of
+    internal notifications. A FDB shard produces under its lock, the thread
+    sending the notifications consumes without it*/
+typedef struct _sai_fdb_notification_ring_t {
+    /*head: Free running index of the next notification to send, written by the consumer*/
+    uint_t              head;
+    /*tail: Free running index of the next free slot, written by the producer*/
+    uint_t              tail;
+    /*num_enqueued: Number of notifications queued on the ring*/
+    uint64_t            num_enqueued;
+    /*num_overflows: Number of notifications spilled to the changelist as the ring was full*/
+    uint64_t            num_overflows;
+    /*num_coalesced: Number of notifications spilled to the changelist as the entry was
+      still on the ring*/
+    uint64_t            num_coalesced;
+    /*num_drops: Number of spilled notifications replaced by a later one for the same entry*/
+    uint64_t            num_drops;
+    /*num_dampened: Number of notifications collapsed while their entry was dampened*/
+    uint64_t            num_dampened;
+    /*data: Ring slots*/
+    sai_fdb_internal_notification_data_t data[SAI_FDB_NOTIFICATION_RING_SIZE];
+} sai_fdb_notification_ring_t;
+
+/** FDB Notification statistics: Snapshot of the notification queue counters*/
+typedef struct _sai_fdb_notification_stats_t {
+    /*queue_depth: Number of notifications on the ring*/
+    uint_t   queue_depth;
+    /*queue_size: Number of ring slots*/
+    uint_t   queue_size;
+    /*num_spilled: Number of notifications waiting on the changelist*/
+    uint_t   num_spilled;
+    /*num_enqueued: Number of notifications queued on the ring*/
+    uint64_t num_enqueued;
+    /*num_overflows: Number of notifications spilled to the changelist as the ring was full*/
+    uint64_t num_overflows;
+    /*num_coalesced: Number of notifications spilled to the changelist as the entry was
+      still on the ring*/
+    uint64_t num_coalesced;
+    /*num_drops: Number of spilled notifications replaced by a later one for the same entry*/
+    uint64_t num_drops;
+    /*num_dampened: Number of notifications collapsed while their entry was dampened*/
+    uint64_t num_dampened;
+    /*num_dampened_entries: Number of entries currently dampened*/
+    uint_t   num_dampened_entries;
+} sai_fdb_notification_stats_t;
+
 /** FDB event data: Data generated as part of a FDB event*/
 typedef struct _sai_fdb_event_data_t {
     /* Data for notifying to registered modules */
@@ -95,17 +222,80 @@ typedef struct _sai_fdb_event_data_t {
     bool is_pending_entry;
 } sai_fdb_event_data_t;
 
-typedef struct _sai_fdb_global_data_t {
-    /*sai_global_fdb_tree: FDB entry global tree*/
+/** FDB Hash slot: Slot of the FDB exact match index*/
+typedef struct _sai_fdb_hash_slot_t {
+    /*key: Packed FDB entry key of the node*/
+    uint64_t              key;
+    /*fdb_entry_node: FDB entry node held by the slot*/
+    sai_fdb_entry_node_t *fdb_entry_node;
+} sai_fdb_hash_slot_t;
+
+/** FDB Hash index: Exact match index of the FDB entry nodes. Open addressing
+    table probed in groups of slots, with one control byte per slot holding
+    7 bits of the key hash or an empty/deleted marker*/
+typedef struct _sai_fdb_hash_index_t {
+    /*ctrl: Control bytes, one per slot*/
+    int8_t              *ctrl;
+    /*slots: Slots holding the FDB entry nodes*/
+    sai_fdb_hash_slot_t *slots;
+    /*group_count: Number of slot groups, a power of two*/
+    uint_t               group_count;
+    /*used: Number of slots holding a node*/
+    uint_t               used;
+    /*deleted: Number of slots holding the deleted marker*/
+    uint_t               deleted;
+} sai_fdb_hash_index_t;
+
+/** FDB Shard: FDB entries of the VLANs hashing to the shard, with their own lock*/
+typedef struct _sai_fdb_shard_t {
+    /*lock: Lock of the shard*/
+    std_mutex_type_t    lock;
+    /*sai_global_fdb_tree: FDB entry tree of the shard, used for ordered walks*/
     std_rt_table       *sai_global_fdb_tree;
-    /*sai_registered_fdb_entry_tree: Tree containing registered FDB entries*/
+    /*fdb_hash_index: Exact match index of the nodes in sai_global_fdb_tree*/
+    sai_fdb_hash_index_t fdb_hash_index;
+    /*sai_registered_fdb_entry_tree: Tree containing registered FDB entries of the shard*/
     std_rt_table       *sai_registered_fdb_entry_tree;
+    /*fdb_port_tree: Tree of FDB port nodes of the shard*/
+    rbtree_handle       fdb_port_tree;
+    /*free_nodes: Free FDB entry nodes, chained through their first word*/
+    sai_fdb_entry_node_t *free_nodes;
+    /*num_free_nodes: Number of nodes in free_nodes*/
+    uint_t             num_free_nodes;
+    /*num_registered_entries: Number of nodes in sai_registered_fdb_entry_tree*/
+    uint_t             num_registered_entries;
+    /*registered_filter: Counting bloom filter of the keys in sai_registered_fdb_entry_tree,
+      in blocks of one cache line. Registered entries tend to be in a few VLANs, so each
+      shard gets a filter sized for the whole registered set*/
+    uint8_t            registered_filter[SAI_FDB_REGISTERED_FILTER_SIZE];
     /*fdb_notification_marker: Marker node for changelist in registered FDB entry tree*/
     std_radical_ref_t  fdb_marker;
-    /*num_notifications: Number of notifications pending to be sent*/
+    /*num_notifications: Number of notifications spilled to the changelist, pending to be sent*/
     uint_t             num_notifications;
-    /*cur_notification_idx: Current number of notification be added to array by notification thread*/
-    uint_t             cur_notification_idx;
+    /*notification_ring: Queue of notifications pending to be sent*/
+    sai_fdb_notification_ring_t notification_ring;
+    /*dampened_list: Registered nodes whose notifications are held*/
+    std_dll_head       dampened_list;
+    /*num_dampened_entries: Number of nodes in dampened_list*/
+    uint_t             num_dampened_entries;
+    /*next_release_ms: Earliest release time of the nodes in dampened_list*/
+    uint64_t           next_release_ms;
+} sai_fdb_shard_t;
+
+typedef struct _sai_fdb_global_data_t {
+    /*shards: FDB shards, a VLAN belongs to the shard its identifier hashes to*/
+    sai_fdb_shard_t    shards[SAI_FDB_NUM_SHARDS];
+    /*fdb_vlan_nodes: FDB VLAN nodes indexed by VLAN identifier, each protected by the
+      lock of the shard of the VLAN*/
+    sai_fdb_vlan_node_t fdb_vlan_nodes[SAI_MAX_VLAN_TAG_ID + 1];
+    /*fdb_port_learn_tree: Tree of FDB port learn nodes*/
+    rbtree_handle       fdb_port_learn_tree;
+    /*move_damp_window_ms: MAC move dampening window, 0 if dampening is disabled*/
+    uint_t             move_damp_window_ms;
+    /*move_damp_threshold: Number of moves within a window above which an entry is dampened*/
+    uint_t             move_damp_threshold;
+    /*notification_batch: Buffer the changelists are walked into by the notification thread*/
+    sai_fdb_internal_notification_data_t notification_batch[SAI_FDB_MAX_NOTIFICATION_NODES];
 } sai_fdb_global_data_t;
 #define SAI_FDB_ENTRY_KEY_SIZE (sizeof(sai_fdb_entry_key_t)*8)
 
@@ -114,8 +304,8 @@ typedef struct _sai_fdb_global_data_t {
 #define SAI_MAC_NUM_CHAR_PER_BYTE 3
 #define SAI_MAC_STR_LEN (SAI_MAC_NUM_CHAR_PER_BYTE*SAI_MAC_NUM_BYTES)
 #define SAI_FDB_LEARN_LIMIT_DISABLE 0
-#define SAI_FDB_MAX_NOTIFICATION_NODES 50
 #define SAI_FDB_MAX_MACS_PER_CALLBACK 1000
+#define SAI_FDB_NODE_POOL_CHUNK 256
 
 /** Logging utility for SAI FDB API */
 #define SAI_FDB_LOG(level, msg, ...) \
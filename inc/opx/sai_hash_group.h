@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2016 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_hash_group.h
+ *
+ * @brief This file contains the group probing primitives shared by the
+ *        open addressing hash tables of the SAI common code
+ */
+
+#ifndef __SAI_HASH_GROUP_H__
+#define __SAI_HASH_GROUP_H__
+
+#include <stdint.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * The tables probe their slots in groups of SAI_HASH_GROUP_SIZE, using one
+ * control byte per slot: the 7 low order bits of the key hash (h2) when the
+ * slot is in use, or one of the markers below. A whole group of control
+ * bytes is matched at once (with SSE2 when available), so a lookup usually
+ * touches one control group and one slot. The remaining hash bits (h1)
+ * select the first group of the probe sequence.
+ */
+#define SAI_HASH_GROUP_SIZE            (16)
+#define SAI_HASH_CTRL_EMPTY            ((int8_t) -128)
+#define SAI_HASH_CTRL_DELETED          ((int8_t) -2)
+
+/*
+ * 64 bit finalizer from MurmurHash3. Every input bit affects every output
+ * bit, so keys that differ only in a few high order bits still spread out.
+ */
+static inline uint64_t sai_hash_mix64 (uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+static inline int8_t sai_hash_h2 (uint64_t hash)
+{
+    return (int8_t) (hash & 0x7f);
+}
+
+static inline uint32_t sai_hash_h1 (uint64_t hash)
+{
+    return (uint32_t) (hash >> 7);
+}
+
+/* Bitmask of the slots in the group whose control byte equals 'ctrl' */
+static inline uint32_t sai_hash_group_match (const int8_t *group, int8_t ctrl)
+{
+#if defined(__SSE2__)
+    __m128i grp = _mm_loadu_si128 ((const __m128i *) group);
+
+    return (uint32_t) _mm_movemask_epi8 (_mm_cmpeq_epi8 (grp, _mm_set1_epi8 (ctrl)));
+#else
+    uint32_t mask = 0;
+    uint32_t idx;
+
+    for (idx = 0; idx < SAI_HASH_GROUP_SIZE; idx++) {
+        if (group [idx] == ctrl) {
+            mask |= (1 << idx);
+        }
+    }
+    return mask;
+#endif
+}
+
+/* Bitmask of the slots in the group that are empty or deleted */
+static inline uint32_t sai_hash_group_match_free (const int8_t *group)
+{
+#if defined(__SSE2__)
+    __m128i grp = _mm_loadu_si128 ((const __m128i *) group);
+
+    /* Both markers are negative, while used slots hold 0..127 */
+    return (uint32_t) _mm_movemask_epi8 (grp);
+#else
+    uint32_t mask = 0;
+    uint32_t idx;
+
+    for (idx = 0; idx < SAI_HASH_GROUP_SIZE; idx++) {
+        if (group [idx] < 0) {
+            mask |= (1 << idx);
+        }
+    }
+    return mask;
+#endif
+}
+
+/*
+ * Triangular probing over the groups of a table of '_group_count' groups.
+ * With a power of two group count this visits every group exactly once.
+ */
+#define SAI_HASH_FOR_EACH_PROBE_GROUP(_group_count, _hash, _group, _probe)        \
+    for ((_probe) = 0, (_group) = sai_hash_h1 (_hash) & ((_group_count) - 1);     \
+         (_probe) < (_group_count);                                              \
+         (_probe)++, (_group) = ((_group) + (_probe)) & ((_group_count) - 1))
+
+#endif /* __SAI_HASH_GROUP_H__ */
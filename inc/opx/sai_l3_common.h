@@ -143,8 +143,6 @@ typedef struct _sai_fib_router_interface_t {
     /** Action for Packets with IP options */
     sai_packet_action_t          ip_options_pkt_action;
 
-    uint_t                       ref_count;
-
     /** Place holder for NPU-specific data */
     void                        *hw_info;
 } sai_fib_router_interface_t;
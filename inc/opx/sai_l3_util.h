@@ -395,6 +395,16 @@ bool sai_fib_is_rif_created (sai_object_id_t rif_id);
 sai_status_t sai_rif_increment_ref_count (sai_object_id_t rif_id);
 
 sai_status_t sai_rif_decrement_ref_count (sai_object_id_t rif_id);
+
+/**
+ * @brief Check if router interface is referenced through
+ *        sai_rif_increment_ref_count. The RIF node holds no count
+ *        of its own, so RIF remove must check this instead.
+ *
+ * @param[in] rif_id    Router Interface id
+ * @return true if reference count greater than zero, false otherwise
+ */
+bool sai_is_rif_in_use (sai_object_id_t rif_id);
 /**
  * @brief Get SAI FIB Next Hop node using next_hop_id.
  *
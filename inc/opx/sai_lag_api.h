@@ -291,7 +291,7 @@ sai_status_t sai_lag_def_bridge_port_get (sai_object_id_t lag_id, sai_object_id_
  * @brief Check if the LAG is in use
  *
  * @param[in] lag_id SAI LAG identifier
- * @return true if ref_count > 0, false otherwise
+ * @return true if reference count greater than zero, false otherwise
  *
  */
 bool sai_is_lag_in_use (sai_object_id_t lag_id);
@@ -64,8 +64,6 @@ typedef struct _sai_lag_node_t {
     unsigned int port_count;
     /** Bridge port object ID that is added to 1Q bridge */
     sai_object_id_t def_bridge_port_id;
-    /* Number of objects referencing LAG Object */
-    uint_t       ref_count;
 }sai_lag_node_t;
 
 #define SAI_LAG_ID_OFFSET STD_STR_OFFSET_OF(sai_lag_node_t,sai_lag_id)
@@ -0,0 +1,576 @@
+/*
+ * Copyright (c) 2017 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_map_relation.h
+ *
+ * @brief Typed C++ front-end to the SAI map utility.
+ *
+ * A relation fixes, at compile time, the map type and the layout of its
+ * key and value, and where it is stored. Callers pass plain structures
+ * holding only the fields the relation uses.
+ *
+ * Relations tagged with sai_map_tag live in the sai_map stripes of their
+ * map type, and their sai_map_key_t / sai_map_data_t arguments are built by
+ * value from the layouts, with no memset and no type field to set.
+ *
+ * Relations from one object to a list of objects, tagged with
+ * sai_oid_relation_tag, live in the object relation store instead
+ * (sai_map_relation.cpp). Its slots hold the key object alone and its
+ * elements are single object ids, so that a slot holds five elements
+ * inline in one cache line where a sai_map slot holds two, and lists take
+ * half the memory. The map types stored there are listed in
+ * SAI_MAP_OID_RELATION_TYPES, and are only accessible through their
+ * relation, apart from sai_map_reserve() and sai_map_stats_get().
+ */
+
+#ifndef _SAI_MAP_RELATION_H_
+#define _SAI_MAP_RELATION_H_
+
+#include "sai_map_utl.h"
+
+#ifdef __cplusplus
+
+#include <stdlib.h>
+
+/*
+ * Map types kept in the object relation store, as a bitmap of
+ * sai_map_type_t. All of them relate one object to a list of objects.
+ */
+#define SAI_MAP_OID_RELATION_TYPES                                  \
+    ((1ULL << SAI_MAP_TYPE_BRIDGE_TO_BRIDGE_PORT_LIST)            | \
+     (1ULL << SAI_MAP_TYPE_LAG_TO_BRIDGE_PORT_LIST)               | \
+     (1ULL << SAI_MAP_TYPE_BRIDGE_PORT_TO_VLAN_MEMBER_LIST)       | \
+     (1ULL << SAI_MAP_TYPE_BRIDGE_PORT_TO_STP_PORT_LIST)          | \
+     (1ULL << SAI_MAP_TYPE_TUNNEL_TO_BRIDGE_PORT_LIST)            | \
+     (1ULL << SAI_MAP_TYPE_BRIDGE_PORT_TO_L2MC_MEMBER_LIST)       | \
+     (1ULL << SAI_MAP_TYPE_LAG_PORT_TO_BRIDGE_PORT_LIST)          | \
+     (1ULL << SAI_MAP_TYPE_BRIDGE_PORT_TYPE_TO_BRIDGE_PORT_LIST))
+
+static inline constexpr bool sai_map_oid_relation_type (sai_map_type_t type)
+{
+    return (((uint32_t) type < SAI_MAP_TYPE_MAX) &&
+            (((SAI_MAP_OID_RELATION_TYPES >> type) & 1) != 0));
+}
+
+extern "C" {
+
+/*
+ * Object relation store. These are used through sai_relation, and follow
+ * the sai_map function of the same name for arguments and return codes,
+ * with single object ids in place of keys and elements.
+ */
+sai_status_t sai_oid_relation_insert (sai_map_type_t type, sai_object_id_t key,
+                                      sai_object_id_t val);
+
+sai_status_t sai_oid_relation_remove (sai_map_type_t type, sai_object_id_t key,
+                                      sai_object_id_t val);
+
+sai_status_t sai_oid_relation_erase (sai_map_type_t type, sai_object_id_t key);
+
+sai_status_t sai_oid_relation_bulk_insert (sai_map_type_t         type,
+                                           uint32_t               count,
+                                           const sai_object_id_t *key_list,
+                                           const sai_object_id_t *val_list,
+                                           sai_status_t          *status_list);
+
+sai_status_t sai_oid_relation_reserve (sai_map_type_t type, uint32_t count);
+
+sai_status_t sai_oid_relation_get (sai_map_type_t type, sai_object_id_t key,
+                                   sai_object_id_t *val);
+
+sai_status_t sai_oid_relation_get_at_index (sai_map_type_t type, sai_object_id_t key,
+                                            uint32_t index, sai_object_id_t *val);
+
+sai_status_t sai_oid_relation_count (sai_map_type_t type, sai_object_id_t key,
+                                     uint32_t *count);
+
+sai_status_t sai_oid_relation_val_list (sai_map_type_t type, sai_object_id_t key,
+                                        uint32_t *count, sai_object_id_t *val_list);
+
+bool sai_oid_relation_contains (sai_map_type_t type, sai_object_id_t key,
+                                sai_object_id_t val);
+
+sai_status_t sai_oid_relation_foreach (sai_map_type_t type, sai_object_id_t key,
+                                       sai_map_visit_fn visit_fn, void *ctx);
+
+/* Only for types with a reverse index, see sai_map_type_t */
+sai_status_t sai_oid_relation_reverse_get (sai_map_type_t type, sai_object_id_t val,
+                                           sai_object_id_t *key);
+
+sai_status_t sai_oid_relation_stats_get (sai_map_type_t type, sai_map_stats_t *stats);
+
+}
+
+/** Key of a relation keyed on a single object */
+typedef struct _sai_map_oid_key_t {
+    sai_object_id_t id;
+} sai_map_oid_key_t;
+
+/** Key of a relation keyed on an object and a second identifier */
+typedef struct _sai_map_oid_pair_key_t {
+    sai_object_id_t id1;
+    sai_object_id_t id2;
+} sai_map_oid_pair_key_t;
+
+/** Element of a relation mapping to single objects */
+typedef struct _sai_map_oid_val_t {
+    sai_object_id_t val1;
+} sai_map_oid_val_t;
+
+/** Element of a relation mapping to pairs of objects */
+typedef struct _sai_map_oid_pair_val_t {
+    sai_object_id_t val1;
+    sai_object_id_t val2;
+} sai_map_oid_pair_val_t;
+
+/**
+ * @brief Conversion of a key or value layout to and from the map structures
+ *
+ * Specialized for each layout above. Value layouts also give the filter
+ * that matches all of their fields.
+ */
+template <typename T> struct sai_map_layout;
+
+template <> struct sai_map_layout<sai_map_oid_key_t> {
+    static inline sai_map_key_t to_map (sai_map_type_t type, const sai_map_oid_key_t &key)
+    {
+        sai_map_key_t map_key = {type, key.id, SAI_NULL_OBJECT_ID};
+        return map_key;
+    }
+
+    static inline sai_map_oid_key_t from_map (const sai_map_key_t &map_key)
+    {
+        sai_map_oid_key_t key = {map_key.id1};
+        return key;
+    }
+};
+
+template <> struct sai_map_layout<sai_map_oid_pair_key_t> {
+    static inline sai_map_key_t to_map (sai_map_type_t type, const sai_map_oid_pair_key_t &key)
+    {
+        sai_map_key_t map_key = {type, key.id1, key.id2};
+        return map_key;
+    }
+
+    static inline sai_map_oid_pair_key_t from_map (const sai_map_key_t &map_key)
+    {
+        sai_map_oid_pair_key_t key = {map_key.id1, map_key.id2};
+        return key;
+    }
+};
+
+template <> struct sai_map_layout<sai_map_oid_val_t> {
+    static const sai_map_val_filter_t filter = SAI_MAP_VAL_FILTER_VAL1;
+
+    static inline sai_map_data_t to_map (const sai_map_oid_val_t &val)
+    {
+        sai_map_data_t data = {val.val1, SAI_NULL_OBJECT_ID};
+        return data;
+    }
+
+    static inline sai_map_oid_val_t from_map (const sai_map_data_t &data)
+    {
+        sai_map_oid_val_t val = {data.val1};
+        return val;
+    }
+};
+
+template <> struct sai_map_layout<sai_map_oid_pair_val_t> {
+    static const sai_map_val_filter_t filter =
+        (sai_map_val_filter_t) (SAI_MAP_VAL_FILTER_VAL1 | SAI_MAP_VAL_FILTER_VAL2);
+
+    static inline sai_map_data_t to_map (const sai_map_oid_pair_val_t &val)
+    {
+        sai_map_data_t data = {val.val1, val.val2};
+        return data;
+    }
+
+    static inline sai_map_oid_pair_val_t from_map (const sai_map_data_t &data)
+    {
+        sai_map_oid_pair_val_t val = {data.val1, data.val2};
+        return val;
+    }
+};
+
+/** Tag naming the map type of a relation stored in the sai_map */
+template <sai_map_type_t Type> struct sai_map_tag {
+    static_assert (!sai_map_oid_relation_type (Type),
+                   "Map type is kept in the object relation store");
+
+    static const sai_map_type_t type = Type;
+};
+
+/** Tag naming the map type of a relation stored in the object relation store */
+template <sai_map_type_t Type> struct sai_oid_relation_tag {
+    static_assert (sai_map_oid_relation_type (Type),
+                   "Map type is not kept in the object relation store");
+
+    static const sai_map_type_t type = Type;
+};
+
+/**
+ * @brief Typed relation over one map type
+ *
+ * @tparam Tag Tag giving the map type, see sai_map_tag
+ * @tparam Key Key layout of the relation
+ * @tparam Val Value layout of the relation
+ *
+ * Every operation converts its arguments and calls the sai_map API of the
+ * same name, with the same return codes unless stated otherwise.
+ */
+template <typename Tag, typename Key, typename Val>
+struct sai_relation {
+    static_assert (Tag::type < SAI_MAP_TYPE_MAX, "Invalid sai_map type");
+    static_assert (!sai_map_oid_relation_type (Tag::type),
+                   "Object relation store holds object keys and elements only");
+
+    typedef sai_map_layout<Key> key_layout;
+    typedef sai_map_layout<Val> val_layout;
+
+    static inline sai_map_key_t map_key (const Key &key)
+    {
+        return key_layout::to_map (Tag::type, key);
+    }
+
+    /** Append one element to the list of 'key' */
+    static inline sai_status_t insert (const Key &key, const Val &val)
+    {
+        sai_map_key_t  mkey  = map_key (key);
+        sai_map_data_t data  = val_layout::to_map (val);
+        sai_map_val_t  value = {1, &data};
+
+        return sai_map_insert (&mkey, &value);
+    }
+
+    /**
+     * Remove the elements of 'key' matching every field of 'val', and the
+     * key itself once its list is empty. Returns the status of the element
+     * removal.
+     */
+    static inline sai_status_t remove (const Key &key, const Val &val)
+    {
+        sai_map_key_t  mkey  = map_key (key);
+        sai_map_data_t data  = val_layout::to_map (val);
+        sai_map_val_t  value = {1, &data};
+        sai_status_t   rc;
+        uint32_t       count = 0;
+
+        rc = sai_map_delete_elements (&mkey, &value, val_layout::filter);
+
+        if ((sai_map_get_val_count (&mkey, &count) == SAI_STATUS_SUCCESS) && (count == 0)) {
+            sai_map_delete (&mkey);
+        }
+
+        return rc;
+    }
+
+    /** Remove 'key' and its whole list */
+    static inline sai_status_t erase (const Key &key)
+    {
+        sai_map_key_t mkey = map_key (key);
+
+        return sai_map_delete (&mkey);
+    }
+
+    /** Get the only element of 'key' */
+    static inline sai_status_t get (const Key &key, Val *val)
+    {
+        sai_map_key_t  mkey  = map_key (key);
+        sai_map_data_t data  = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+        sai_map_val_t  value = {1, &data};
+        sai_status_t   rc;
+
+        rc = sai_map_get (&mkey, &value);
+        if (rc == SAI_STATUS_SUCCESS) {
+            *val = val_layout::from_map (data);
+        }
+
+        return rc;
+    }
+
+    static inline sai_status_t get_at_index (const Key &key, uint32_t index, Val *val)
+    {
+        sai_map_key_t  mkey  = map_key (key);
+        sai_map_data_t data  = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+        sai_map_val_t  value = {1, &data};
+        sai_status_t   rc;
+
+        rc = sai_map_get_element_at_index (&mkey, index, &value);
+        if (rc == SAI_STATUS_SUCCESS) {
+            *val = val_layout::from_map (data);
+        }
+
+        return rc;
+    }
+
+    static inline sai_status_t count (const Key &key, uint32_t *count)
+    {
+        sai_map_key_t mkey = map_key (key);
+
+        return sai_map_get_val_count (&mkey, count);
+    }
+
+    static inline sai_status_t val1_list (const Key &key, uint32_t *count,
+                                          sai_object_id_t *val1_list)
+    {
+        sai_map_key_t mkey = map_key (key);
+
+        return sai_map_get_val1_list (&mkey, count, val1_list);
+    }
+
+    static inline bool contains (const Key &key, const Val &val)
+    {
+        sai_map_key_t  mkey = map_key (key);
+        sai_map_data_t data = val_layout::to_map (val);
+
+        return sai_map_contains (&mkey, &data, val_layout::filter);
+    }
+
+    static inline sai_status_t foreach (const Key &key, sai_map_visit_fn visit_fn, void *ctx)
+    {
+        sai_map_key_t mkey = map_key (key);
+
+        return sai_map_foreach (&mkey, visit_fn, ctx);
+    }
+
+    /**
+     * Get the only key whose list holds 'val1'. Returns
+     * SAI_STATUS_BUFFER_OVERFLOW if more than one does.
+     */
+    static inline sai_status_t reverse_get (sai_object_id_t val1, Key *key)
+    {
+        sai_map_key_t mkey;
+        uint32_t      count = 1;
+        sai_status_t  rc;
+
+        rc = sai_map_reverse_lookup (Tag::type, val1, &count, &mkey);
+        if (rc == SAI_STATUS_SUCCESS) {
+            *key = key_layout::from_map (mkey);
+        }
+
+        return rc;
+    }
+
+    /**
+     * Append one element to the list of each key, see sai_map_bulk_insert.
+     * 'key_at' and 'val_at' give the key and element of entry 'idx', so
+     * that callers holding separate id lists need not build Key/Val arrays.
+     */
+    template <typename KeyFn, typename ValFn>
+    static sai_status_t bulk_insert (uint32_t count, KeyFn key_at, ValFn val_at,
+                                     sai_status_t *status_list)
+    {
+        sai_map_key_t  *mkey_list;
+        sai_map_val_t  *value_list;
+        sai_map_data_t *data_list;
+        sai_status_t    rc;
+        uint32_t        idx;
+
+        if (count == 0) {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        mkey_list  = (sai_map_key_t *) malloc (count * sizeof (sai_map_key_t));
+        value_list = (sai_map_val_t *) malloc (count * sizeof (sai_map_val_t));
+        data_list  = (sai_map_data_t *) malloc (count * sizeof (sai_map_data_t));
+
+        if ((mkey_list == NULL) || (value_list == NULL) || (data_list == NULL)) {
+            free (mkey_list);
+            free (value_list);
+            free (data_list);
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        /* Every field is assigned below, so the lists need no zeroing */
+        for (idx = 0; idx < count; idx++) {
+            mkey_list [idx]        = map_key (key_at (idx));
+            data_list [idx]        = val_layout::to_map (val_at (idx));
+            value_list [idx].count = 1;
+            value_list [idx].data  = &data_list [idx];
+        }
+
+        rc = sai_map_bulk_insert (count, mkey_list, value_list, status_list);
+
+        free (mkey_list);
+        free (value_list);
+        free (data_list);
+
+        return rc;
+    }
+};
+
+/**
+ * @brief Relation kept in the object relation store
+ *
+ * Same operations and return codes as the generic relation, passing the
+ * object ids straight to the store, with no sai_map key or element built.
+ * Only object keys and object elements are stored there.
+ */
+template <sai_map_type_t Type>
+struct sai_relation<sai_oid_relation_tag<Type>, sai_map_oid_key_t, sai_map_oid_val_t> {
+    static inline sai_status_t insert (const sai_map_oid_key_t &key, const sai_map_oid_val_t &val)
+    {
+        return sai_oid_relation_insert (Type, key.id, val.val1);
+    }
+
+    /**
+     * Remove the first element equal to 'val' from 'key', and the key
+     * itself along with its last element
+     */
+    static inline sai_status_t remove (const sai_map_oid_key_t &key, const sai_map_oid_val_t &val)
+    {
+        return sai_oid_relation_remove (Type, key.id, val.val1);
+    }
+
+    static inline sai_status_t erase (const sai_map_oid_key_t &key)
+    {
+        return sai_oid_relation_erase (Type, key.id);
+    }
+
+    static inline sai_status_t get (const sai_map_oid_key_t &key, sai_map_oid_val_t *val)
+    {
+        return sai_oid_relation_get (Type, key.id, &val->val1);
+    }
+
+    static inline sai_status_t get_at_index (const sai_map_oid_key_t &key, uint32_t index,
+                                             sai_map_oid_val_t *val)
+    {
+        return sai_oid_relation_get_at_index (Type, key.id, index, &val->val1);
+    }
+
+    static inline sai_status_t count (const sai_map_oid_key_t &key, uint32_t *count)
+    {
+        return sai_oid_relation_count (Type, key.id, count);
+    }
+
+    static inline sai_status_t val1_list (const sai_map_oid_key_t &key, uint32_t *count,
+                                          sai_object_id_t *val1_list)
+    {
+        return sai_oid_relation_val_list (Type, key.id, count, val1_list);
+    }
+
+    static inline bool contains (const sai_map_oid_key_t &key, const sai_map_oid_val_t &val)
+    {
+        return sai_oid_relation_contains (Type, key.id, val.val1);
+    }
+
+    static inline sai_status_t foreach (const sai_map_oid_key_t &key, sai_map_visit_fn visit_fn,
+                                        void *ctx)
+    {
+        return sai_oid_relation_foreach (Type, key.id, visit_fn, ctx);
+    }
+
+    static inline sai_status_t reverse_get (sai_object_id_t val1, sai_map_oid_key_t *key)
+    {
+        return sai_oid_relation_reverse_get (Type, val1, &key->id);
+    }
+
+    template <typename KeyFn, typename ValFn>
+    static sai_status_t bulk_insert (uint32_t count, KeyFn key_at, ValFn val_at,
+                                     sai_status_t *status_list)
+    {
+        sai_object_id_t *key_list;
+        sai_object_id_t *val_list;
+        sai_status_t     rc;
+        uint32_t         idx;
+
+        if (count == 0) {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        key_list = (sai_object_id_t *) malloc (count * sizeof (sai_object_id_t));
+        val_list = (sai_object_id_t *) malloc (count * sizeof (sai_object_id_t));
+
+        if ((key_list == NULL) || (val_list == NULL)) {
+            free (key_list);
+            free (val_list);
+            return SAI_STATUS_NO_MEMORY;
+        }
+
+        for (idx = 0; idx < count; idx++) {
+            key_list [idx] = key_at (idx).id;
+            val_list [idx] = val_at (idx).val1;
+        }
+
+        rc = sai_oid_relation_bulk_insert (Type, count, key_list, val_list, status_list);
+
+        free (key_list);
+        free (val_list);
+
+        return rc;
+    }
+};
+
+/*
+ * Relations for every map type, with the layouts documented in
+ * sai_map_type_t. Those tagged with sai_oid_relation_tag are kept in the
+ * object relation store.
+ */
+typedef sai_relation<sai_map_tag<SAI_MAP_TYPE_NH_GRP_2_MEMBER_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_nh_grp_member_relation_t;
+
+typedef sai_relation<sai_map_tag<SAI_MAP_TYPE_NH_MEMBER_2_GRP_INFO>,
+                     sai_map_oid_key_t, sai_map_oid_pair_val_t> sai_nh_member_grp_relation_t;
+
+typedef sai_relation<sai_map_tag<SAI_MAP_TYPE_PORT_TC_AND_COLOR_MAP_LIST>,
+                     sai_map_oid_pair_key_t, sai_map_oid_pair_val_t>
+                                                        sai_port_tc_color_map_relation_t;
+
+typedef sai_relation<sai_map_tag<SAI_MAP_TYPE_LAG_RIF_INFO>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_lag_rif_relation_t;
+
+typedef sai_relation<sai_oid_relation_tag<SAI_MAP_TYPE_BRIDGE_TO_BRIDGE_PORT_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_bridge_bridge_port_relation_t;
+
+typedef sai_relation<sai_map_tag<SAI_MAP_TYPE_PORT_VLAN_TO_BRIDGE_PORT_LIST>,
+                     sai_map_oid_pair_key_t, sai_map_oid_val_t>
+                                                        sai_port_vlan_bridge_port_relation_t;
+
+typedef sai_relation<sai_oid_relation_tag<SAI_MAP_TYPE_LAG_TO_BRIDGE_PORT_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_lag_bridge_port_relation_t;
+
+typedef sai_relation<sai_oid_relation_tag<SAI_MAP_TYPE_BRIDGE_PORT_TO_VLAN_MEMBER_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_bridge_port_vlan_member_relation_t;
+
+typedef sai_relation<sai_oid_relation_tag<SAI_MAP_TYPE_BRIDGE_PORT_TO_STP_PORT_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_bridge_port_stp_port_relation_t;
+
+typedef sai_relation<sai_oid_relation_tag<SAI_MAP_TYPE_TUNNEL_TO_BRIDGE_PORT_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_tunnel_bridge_port_relation_t;
+
+typedef sai_relation<sai_map_tag<SAI_MAP_TYPE_TUNNEL_MAP_TO_TUNNEL_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_tunnel_map_tunnel_relation_t;
+
+typedef sai_relation<sai_oid_relation_tag<SAI_MAP_TYPE_BRIDGE_PORT_TO_L2MC_MEMBER_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_bridge_port_l2mc_member_relation_t;
+
+typedef sai_relation<sai_map_tag<SAI_MAP_TYPE_BRIDGE_TUNNEL_TO_BRIDGE_PORT_LIST>,
+                     sai_map_oid_pair_key_t, sai_map_oid_val_t>
+                                                        sai_bridge_tunnel_bridge_port_relation_t;
+
+typedef sai_relation<sai_oid_relation_tag<SAI_MAP_TYPE_LAG_PORT_TO_BRIDGE_PORT_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_lag_port_bridge_port_relation_t;
+
+typedef sai_relation<sai_oid_relation_tag<SAI_MAP_TYPE_BRIDGE_PORT_TYPE_TO_BRIDGE_PORT_LIST>,
+                     sai_map_oid_key_t, sai_map_oid_val_t> sai_bridge_port_type_relation_t;
+
+typedef sai_relation<sai_map_tag<SAI_MAP_TYPE_OBJ_TO_REF_COUNT>,
+                     sai_map_oid_key_t, sai_map_oid_pair_val_t> sai_obj_ref_count_relation_t;
+
+#endif /* __cplusplus */
+
+#endif /* _SAI_MAP_RELATION_H_ */
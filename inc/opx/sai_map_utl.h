@@ -24,6 +24,15 @@
 #include "saistatus.h"
 #include "saitypes.h"
 
+/*
+ * Map types, with the layout of their keys and values.
+ *
+ * Types marked "Object relation store" are kept by their relation in
+ * sai_map_relation.h rather than in the map. The functions below return
+ * SAI_STATUS_INVALID_PARAMETER (false for sai_map_contains) for them,
+ * except sai_map_reserve() and sai_map_stats_get(), which apply to the
+ * relation.
+ */
 typedef enum {
     /*
      * Key
@@ -35,6 +44,8 @@ typedef enum {
      * sai_map_data_t.val1 : nhGroupMember Oid.
      *
      * nhGroupOid --> list <nhGroupMemberOids>
+     *
+     * Reverse indexed: nhGroupMemberOid --> nhGroupOid
      */
     SAI_MAP_TYPE_NH_GRP_2_MEMBER_LIST,
 
@@ -52,6 +63,8 @@ typedef enum {
      *
      * NOTE:
      * 'sai_map_val_t' will NOT be a list, but a single element.
+     * The group of a member is also available from the reverse index of
+     * SAI_MAP_TYPE_NH_GRP_2_MEMBER_LIST.
      */
     SAI_MAP_TYPE_NH_MEMBER_2_GRP_INFO,
 
@@ -92,6 +105,10 @@ typedef enum {
      * sai_map_data_t.val1 : bridge port id.
      *
      * {bridge_id} --> {bridge_port_id} list
+     *
+     * Reverse indexed: {bridge_port_id} --> {bridge_id}
+     *
+     * Object relation store.
      */
     SAI_MAP_TYPE_BRIDGE_TO_BRIDGE_PORT_LIST,
 
@@ -118,6 +135,8 @@ typedef enum {
      * sai_map_data_t.val1 : bridge port id.
      *
      * {lag_id} --> {bridge_port_id} list
+     *
+     * Object relation store.
      */
     SAI_MAP_TYPE_LAG_TO_BRIDGE_PORT_LIST,
 
@@ -131,6 +150,8 @@ typedef enum {
      * sai_map_data_t.val1 : Vlan member id.
      *
      * {bridge_port_id} --> {vlan_member} list
+     *
+     * Object relation store.
      */
     SAI_MAP_TYPE_BRIDGE_PORT_TO_VLAN_MEMBER_LIST,
 
@@ -144,6 +165,8 @@ typedef enum {
      * sai_map_data_t.val1 : Stp Port id.
      *
      * {bridge_port_id} --> {stp_port} list
+     *
+     * Object relation store.
      */
     SAI_MAP_TYPE_BRIDGE_PORT_TO_STP_PORT_LIST,
 
@@ -157,6 +180,8 @@ typedef enum {
      * sai_map_data_t.val1 : Bridge port id.
      *
      * {tunnel_id} --> {bridge_port_id} list
+     *
+     * Object relation store.
      */
     SAI_MAP_TYPE_TUNNEL_TO_BRIDGE_PORT_LIST,
 
@@ -170,6 +195,8 @@ typedef enum {
      * sai_map_data_t.val1 : Tunnel id.
      *
      * {tunnel_map_id} --> {tunnel_id} list
+     *
+     * Reverse indexed: {tunnel_id} --> {tunnel_map_id} list
      */
     SAI_MAP_TYPE_TUNNEL_MAP_TO_TUNNEL_LIST,
 
@@ -183,8 +210,77 @@ typedef enum {
      * sai_map_data_t.val1 : L2mc member id.
      *
      * {bridge_port_id} --> {l2mc_member} list
+     *
+     * Object relation store.
      */
     SAI_MAP_TYPE_BRIDGE_PORT_TO_L2MC_MEMBER_LIST,
+
+    /*
+     * Key
+     * ---
+     * sai_map_key_t.id1   : Bridge id,
+     * sai_map_key_t.id2   : Tunnel id.
+     *
+     * Value
+     * -----
+     * sai_map_data_t.val1 : Bridge port id.
+     *
+     * {bridge_id, tunnel_id} --> {bridge_port_id} list
+     *
+     * Reverse indexed: {bridge_port_id} --> {bridge_id, tunnel_id}
+     * Maintained by the bridge port cache.
+     */
+    SAI_MAP_TYPE_BRIDGE_TUNNEL_TO_BRIDGE_PORT_LIST,
+
+    /*
+     * Key
+     * ---
+     * sai_map_key_t.id1   : Lag id,
+     *
+     * Value
+     * -----
+     * sai_map_data_t.val1 : Bridge port id.
+     *
+     * {lag_id} --> {bridge_port_id} list
+     *
+     * Maintained by the bridge port cache. Object relation store.
+     */
+    SAI_MAP_TYPE_LAG_PORT_TO_BRIDGE_PORT_LIST,
+
+    /*
+     * Key
+     * ---
+     * sai_map_key_t.id1   : Bridge port type,
+     *
+     * Value
+     * -----
+     * sai_map_data_t.val1 : Bridge port id.
+     *
+     * {bridge_port_type} --> {bridge_port_id} list
+     *
+     * Maintained by the bridge port cache. Object relation store.
+     */
+    SAI_MAP_TYPE_BRIDGE_PORT_TYPE_TO_BRIDGE_PORT_LIST,
+
+    /*
+     * Key
+     * ---
+     * sai_map_key_t.id1   : Object id,
+     *
+     * Value
+     * -----
+     * sai_map_data_t.val1 : Index of the counter in the sai_ref_count
+     *                       handle table,
+     * sai_map_data_t.val2 : Generation of the counter.
+     *
+     * {obj_id} --> {counter, generation}
+     *
+     * Maintained by sai_ref_count.cpp, for referenced objects only.
+     */
+    SAI_MAP_TYPE_OBJ_TO_REF_COUNT,
+
+    /* Number of map types. Must be the last entry. */
+    SAI_MAP_TYPE_MAX,
 } sai_map_type_t;
 
 typedef enum {
@@ -229,6 +325,66 @@ typedef struct _sai_map_val_t {
     sai_map_data_t *data;
 } sai_map_val_t;
 
+/* Number of elements a key stores inline before it needs a separate list */
+#define SAI_MAP_INLINE_COUNT  (2)
+
+/**
+ * @brief Cursor over the value list of a key
+ *
+ * A cursor gives in-place access to a snapshot of the list taken when the
+ * cursor was opened. Writers that modify the list afterwards do so on a
+ * copy, so the snapshot stays valid until the cursor is closed, without
+ * any lock being held. Lists short enough to be stored inline in the map
+ * are copied into the cursor instead. The fields are private to the map
+ * utility.
+ */
+typedef struct _sai_map_cursor_t {
+    void           *list;
+    uint32_t        count;
+    uint32_t        index;
+    sai_map_data_t  inline_data [SAI_MAP_INLINE_COUNT];
+} sai_map_cursor_t;
+
+/**
+ * @brief Callback invoked by sai_map_foreach for each element of a list
+ *
+ * @param[in] data Element in the map storage, valid during the callback only
+ * @param[in] ctx Context passed to sai_map_foreach
+ * @return true to continue the walk, false to stop it
+ */
+typedef bool (*sai_map_visit_fn) (const sai_map_data_t *data, void *ctx);
+
+/**
+ * @brief Runtime statistics of a map type
+ *
+ * Key and value counts are current when the statistics are read. They are
+ * kept per stripe as keys are updated, and read without locking, so
+ * stripes updated during the read may be seen before or after the update.
+ * The other fields are cumulative since init.
+ */
+typedef struct _sai_map_stats_t {
+    /* Number of keys */
+    uint64_t key_count;
+
+    /* Number of elements over all keys */
+    uint64_t value_count;
+
+    /* Most elements any key has held since init */
+    uint32_t max_value_count;
+
+    /* Lookups that found, and did not find, their key */
+    uint64_t lookup_hit;
+    uint64_t lookup_miss;
+
+    /*
+     * Stripe lock acquisitions, and time spent waiting for and holding
+     * them, estimated from a sample of the acquisitions
+     */
+    uint64_t lock_count;
+    uint64_t lock_wait_ns;
+    uint64_t lock_hold_ns;
+} sai_map_stats_t;
+
 #ifdef __cplusplus
 extern "C"{
 #endif
@@ -240,6 +396,65 @@ sai_status_t sai_map_delete (sai_map_key_t *key);
 sai_status_t sai_map_delete_elements (sai_map_key_t        *key,
                                       sai_map_val_t        *value,
                                       sai_map_val_filter_t  filter);
+/*
+ * NOTE:
+ *   Lists of more than a few tens of elements are indexed on val1, and
+ *   deleting from them moves the last element into the freed position.
+ *   Callers must not rely on the order of elements in such lists.
+ */
+
+/**
+ * @brief Insert the elements of several keys at once
+ *        Entries are grouped by stripe and by key, so that each stripe
+ *        lock is taken once and each list is sized once for the batch.
+ *        Entries of the same key are applied in request order.
+ *
+ * @param[in] count Number of entries
+ * @param[in] key_list List of keys
+ * @param[in] value_list List of elements to be appended to each key
+ * @param[out] status_list Status of each entry
+ * @return SAI_STATUS_SUCCESS if every entry succeeded, SAI_STATUS_FAILURE
+ *  if any failed, otherwise a different error code is returned and
+ *  status_list is not filled.
+ */
+sai_status_t sai_map_bulk_insert (uint32_t             count,
+                                  const sai_map_key_t *key_list,
+                                  const sai_map_val_t *value_list,
+                                  sai_status_t        *status_list);
+
+/**
+ * @brief Delete the elements of several keys at once
+ *        Entries are grouped by stripe, so that each stripe lock is taken
+ *        once for the batch.
+ *
+ * @param[in] count Number of entries
+ * @param[in] key_list List of keys
+ * @param[in] value_list List of elements to be deleted from each key, as
+ *            with sai_map_delete_elements(). NULL deletes the keys.
+ * @param[in] filter Fields of the elements to be matched
+ * @param[out] status_list Status of each entry
+ * @return SAI_STATUS_SUCCESS if every entry succeeded, SAI_STATUS_FAILURE
+ *  if any failed, otherwise a different error code is returned and
+ *  status_list is not filled.
+ */
+sai_status_t sai_map_bulk_delete (uint32_t             count,
+                                  const sai_map_key_t *key_list,
+                                  const sai_map_val_t *value_list,
+                                  sai_map_val_filter_t filter,
+                                  sai_status_t        *status_list);
+
+/**
+ * @brief Size the map of a type for an expected number of keys
+ *        This is a hint, typically given at init from the switch table
+ *        sizes. The map still grows past it on demand, migrating a few
+ *        entries on each update rather than all of them at once.
+ *
+ * @param[in] type Map type
+ * @param[in] count Number of keys expected for the type
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_map_reserve (sai_map_type_t type, uint32_t count);
 
 sai_status_t sai_map_get (sai_map_key_t *key, sai_map_val_t *val);
 /**
@@ -263,6 +478,124 @@ sai_status_t sai_map_get_elements (sai_map_key_t        *key,
 
 sai_status_t sai_map_get_val_count (sai_map_key_t *key, uint32_t *count);
 
+/**
+ * @brief Check whether an element is mapped to a key
+ *        Lists with many elements are looked up through an index on
+ *        val1, so the check does not scan the list when the filter
+ *        includes SAI_MAP_VAL_FILTER_VAL1.
+ *
+ * @param[in] key The key whose list is to be searched
+ * @param[in] data Element to be looked up
+ * @param[in] filter Fields of 'data' to be matched
+ * @return true if a matching element is present, false otherwise
+ */
+bool sai_map_contains (const sai_map_key_t *key, const sai_map_data_t *data,
+                       sai_map_val_filter_t filter);
+
+/**
+ * @brief Open a cursor on the value list of a key
+ *
+ * @param[in] key The key whose list is to be walked
+ * @param[out] cursor Cursor to be initialized. Must be closed with
+ *             sai_map_cursor_close() once done.
+ * @return SAI_STATUS_SUCCESS if successful, SAI_STATUS_ITEM_NOT_FOUND if
+ *  the key is not present, otherwise a different error code is returned.
+ */
+sai_status_t sai_map_cursor_open (const sai_map_key_t *key, sai_map_cursor_t *cursor);
+
+/**
+ * @brief Get the number of elements in the cursor snapshot
+ *
+ * @param[in] cursor An open cursor
+ * @return Number of elements the cursor will return
+ */
+uint32_t sai_map_cursor_count (const sai_map_cursor_t *cursor);
+
+/**
+ * @brief Get the next element of the cursor snapshot
+ *
+ * @param[inout] cursor An open cursor
+ * @return Pointer to the element in the map storage, valid until the
+ *  cursor is closed, or NULL once all elements have been returned.
+ */
+const sai_map_data_t *sai_map_cursor_next (sai_map_cursor_t *cursor);
+
+/**
+ * @brief Close a cursor and release its snapshot
+ *
+ * @param[inout] cursor An open cursor
+ */
+void sai_map_cursor_close (sai_map_cursor_t *cursor);
+
+/**
+ * @brief Invoke a callback on each element of the value list of a key
+ *        The elements are visited in place on a snapshot of the list, so
+ *        the callback may use any other map API, including modifying
+ *        the same key.
+ *
+ * @param[in] key The key whose list is to be walked
+ * @param[in] visit_fn Callback invoked for each element
+ * @param[in] ctx Context passed to the callback
+ * @return SAI_STATUS_SUCCESS if successful, SAI_STATUS_ITEM_NOT_FOUND if
+ *  the key is not present, otherwise a different error code is returned.
+ */
+sai_status_t sai_map_foreach (const sai_map_key_t *key, sai_map_visit_fn visit_fn, void *ctx);
+
+/**
+ * @brief Get the val1 field of every element mapped to a key
+ *        Elements are copied straight from the map storage into the
+ *        caller list.
+ *
+ * @param[in] key The key whose list is to be read
+ * @param[inout] count Size of val1_list on input, number of elements
+ *               filled on output. On SAI_STATUS_BUFFER_OVERFLOW, it is set
+ *               to the number of elements required.
+ * @param[out] val1_list List to be filled
+ * @return SAI_STATUS_SUCCESS if successful, SAI_STATUS_ITEM_NOT_FOUND if
+ *  the key is not present, otherwise a different error code is returned.
+ */
+sai_status_t sai_map_get_val1_list (const sai_map_key_t *key, uint32_t *count,
+                                    sai_object_id_t *val1_list);
+
+/**
+ * @brief Get the keys whose value list holds a given val1
+ *        Only map types documented as reverse indexed support this.
+ *
+ * @param[in] type Map type to be searched
+ * @param[in] val1 Value to be looked up
+ * @param[inout] count Size of key_list on input, number of keys filled on
+ *               output. On SAI_STATUS_BUFFER_OVERFLOW, it is set to the
+ *               number of keys required.
+ * @param[out] key_list List of keys to be filled
+ * @return SAI_STATUS_SUCCESS if successful, SAI_STATUS_ITEM_NOT_FOUND if
+ *  no key holds the value, SAI_STATUS_NOT_SUPPORTED if the type is not
+ *  reverse indexed, otherwise a different error code is returned.
+ */
+sai_status_t sai_map_reverse_lookup (sai_map_type_t type, sai_object_id_t val1,
+                                     uint32_t *count, sai_map_key_t *key_list);
+
+/**
+ * @brief Get the runtime statistics of a map type
+ *        Counters are kept per thread and summed here, so reading them
+ *        is slower than updating them.
+ *
+ * @param[in] type Map type
+ * @param[out] stats Statistics of the type
+ * @return SAI_STATUS_SUCCESS if successful otherwise a different
+ *  error code is returned.
+ */
+sai_status_t sai_map_stats_get (sai_map_type_t type, sai_map_stats_t *stats);
+
+/**
+ * @brief Dump the runtime statistics of every map type
+ */
+void sai_map_stats_dump (void);
+
+/**
+ * @brief Register the sai_map shell commands
+ */
+void sai_map_shell_cmd_init (void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -325,9 +325,6 @@ typedef struct _sai_port_info_t
     sai_npu_port_id_t     dport_id;
     /** Bridge port object ID that is added to 1Q bridge */
     sai_object_id_t       def_bridge_port_id;
-
-    /** Number of objects referencing this port */
-    uint_t                ref_count;
 } sai_port_info_t;
 
 /**
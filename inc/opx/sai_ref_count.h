@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2017 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/**
+ * @file sai_ref_count.h
+ *
+ * @brief Object reference counts shared by the SAI modules.
+ *
+ * Counts are keyed by object id and held in atomic counters whose handles
+ * are cached per object in the sai_map. Taking or releasing a reference on
+ * an object that is already referenced, and checking whether an object is
+ * in use, take no lock. Only the first reference, which asks the owning
+ * module to validate the object, and the last release take the reference
+ * count lock. The owning module's lock is never taken.
+ *
+ * An object holds a counter only while it is referenced, so nothing has to
+ * be done when objects are created or removed. References must not be
+ * taken on an object concurrently with its removal.
+ */
+
+#ifndef _SAI_REF_COUNT_H_
+#define _SAI_REF_COUNT_H_
+
+#include "saistatus.h"
+#include "saitypes.h"
+#include "std_type_defs.h"
+
+/**
+ * @brief Checks that an object exists before its first reference is taken
+ *
+ * @param[in] obj_id Object identifier
+ * @return true if the object exists, false otherwise
+ */
+typedef bool (*sai_ref_count_obj_check_fn) (sai_object_id_t obj_id);
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Take a reference on an object
+ *
+ * @param[in] obj_id Object identifier
+ * @param[in] obj_check_fn Called under the reference count lock when the object
+ *  is not referenced yet, to check that it exists
+ * @return SAI_STATUS_SUCCESS if successful, SAI_STATUS_ITEM_NOT_FOUND if
+ *  obj_check_fn rejects the object, otherwise a different error code.
+ */
+sai_status_t sai_ref_count_increment (sai_object_id_t            obj_id,
+                                      sai_ref_count_obj_check_fn obj_check_fn);
+
+/**
+ * @brief Release a reference on an object
+ *
+ * @param[in] obj_id Object identifier
+ * @return SAI_STATUS_SUCCESS if successful, SAI_STATUS_ITEM_NOT_FOUND if
+ *  the object holds no reference, otherwise a different error code.
+ */
+sai_status_t sai_ref_count_decrement (sai_object_id_t obj_id);
+
+/**
+ * @brief Get the number of references on an object
+ *
+ * @param[in] obj_id Object identifier
+ * @return Number of references, 0 if the object is not referenced
+ */
+uint_t sai_ref_count_get (sai_object_id_t obj_id);
+
+/**
+ * @brief Check if an object is referenced
+ *
+ * @param[in] obj_id Object identifier
+ * @return true if the reference count is greater than zero, false otherwise
+ */
+bool sai_ref_count_is_in_use (sai_object_id_t obj_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* _SAI_REF_COUNT_H_ */
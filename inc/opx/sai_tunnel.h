@@ -110,9 +110,6 @@ typedef struct _dn_sai_tunnel_t {
     /** List of Tunnel Decap Mappers in the tunnel. */
     sai_object_list_t       tunnel_decap_mapper_list;
 
-    /** Number of bridge ports that reference this tunnel. */
-    uint_t                  ref_count;
-
     /** Place holder for NPU-specific data */
     void                   *hw_info;
 } dn_sai_tunnel_t;
@@ -130,6 +130,10 @@ sai_status_t dn_sai_tunnel_map_dep_tunnel_get_at_index (sai_object_id_t  tunnel_
                                                         uint_t           index,
                                                         sai_object_id_t *tunnel_id);
 
+sai_status_t dn_sai_tunnel_dep_tunnel_map_get (sai_object_id_t  tunnel_id,
+                                               uint_t          *count,
+                                               sai_object_id_t *tunnel_map_list);
+
 static inline bool dn_sai_is_ip_tunnel (dn_sai_tunnel_t *p_tunnel_obj)
 {
     return ((p_tunnel_obj->tunnel_type == SAI_TUNNEL_TYPE_IPINIP) ||
@@ -19,20 +19,814 @@
  */
 
 #include "std_mutex_lock.h"
-#include "sai_map_utl.h"
-#include <unordered_map>
-#include <vector>
+#include "std_assert.h"
+#include "sai_map_relation.h"
+#include "sai_epoch.h"
+#include <atomic>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <inttypes.h>
+#include <sched.h>
 #include "saibridge.h"
 #include "sai_bridge_api.h"
 #include "sai_bridge_common.h"
+#include "sai_oid_utils.h"
 
+/*
+ * Concurrency model
+ * -----------------
+ * Bridges and bridge ports whose NPU object id is below
+ * SAI_BRIDGE_DB_DENSE_MAX live in slabs indexed directly by that id.
+ * Slabs are allocated on first use and never freed, so a dense lookup is
+ * two array loads with no hashing. Any other id goes to a chained hash
+ * table whose buckets and nodes readers walk without taking a lock.
+ * Writers serialize on the store mutex, publish new nodes with release
+ * stores, and retire unlinked nodes, entries and outgrown bucket arrays
+ * instead of freeing them. A retired object is freed once every reader
+ * that could still hold a reference to it has left its read-side section,
+ * with the epoch scheme of sai_epoch.h shared with sai_map_utl.cpp.
+ *
+ * Entries are never moved, so pointers handed out by the cache read APIs
+ * stay valid until the entry is deleted. Those APIs are only for holders
+ * of the bridge lock, which cache writes and deletes are made under. Cache
+ * writes to an existing entry update it in place under the entry sequence
+ * counter, so the cache get APIs always copy out a consistent entry.
+ */
+
+/* Retired objects freed in one go, and initial number of hash buckets */
+#define SAI_BRIDGE_DB_RECLAIM_THRESHOLD  (64)
+#define SAI_BRIDGE_DB_MIN_BUCKETS        (64)
+
+/* Spins on an entry being written before the reader yields the CPU */
+#define SAI_BRIDGE_DB_READ_SPIN_MAX      (128)
+
+/* Dense store geometry. NPU ids below SAI_BRIDGE_DB_DENSE_MAX use slabs. */
+#define SAI_BRIDGE_DB_SLAB_BITS          (8)
+#define SAI_BRIDGE_DB_SLAB_SIZE          (1 << SAI_BRIDGE_DB_SLAB_BITS)
+#define SAI_BRIDGE_DB_SLAB_COUNT         (1024)
+#define SAI_BRIDGE_DB_DENSE_MAX          (SAI_BRIDGE_DB_SLAB_SIZE * SAI_BRIDGE_DB_SLAB_COUNT)
+
+#define SAI_BRIDGE_DB_CACHE_LINE_SIZE    (64)
+
+/*
+ * Entries start on a cache line, so the sequence counter, the id and the
+ * leading fields of the cached info are fetched together.
+ */
+template <typename T>
+struct alignas(SAI_BRIDGE_DB_CACHE_LINE_SIZE) sai_bridge_db_entry_t {
+    /* Odd while a cache write is updating the entry */
+    std::atomic<uint32_t>        seq;
+
+    /* Object id, or SAI_NULL_OBJECT_ID while a slab slot is free */
+    std::atomic<sai_object_id_t> id;
+
+    T                            info;
+
+    /* Only used by entries of the hash table */
+    sai_epoch_obj_t              hdr;
+};
+
+template <typename T>
+struct sai_bridge_db_slab_t {
+    sai_bridge_db_entry_t<T> entry [SAI_BRIDGE_DB_SLAB_SIZE];
+};
+
+template <typename T>
+struct sai_bridge_db_node_t {
+    sai_epoch_obj_t                        hdr;
+    std::atomic<sai_bridge_db_node_t<T> *> next;
+    sai_object_id_t                        id;
+    sai_bridge_db_entry_t<T>              *entry;
+};
+
+template <typename T>
+struct sai_bridge_db_table_t {
+    sai_epoch_obj_t                        hdr;
+    uint32_t                               mask;
+    std::atomic<sai_bridge_db_node_t<T> *> bucket [1];
+};
+
+static inline uint32_t sai_bridge_db_hash (sai_object_id_t id)
+{
+    uint64_t hash = id;
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+
+    return (uint32_t) hash;
+}
+
+/* Returns true and the slab index if the id belongs to the dense store */
+static inline bool sai_bridge_db_dense_index (sai_object_id_t id, uint32_t *index)
+{
+    sai_npu_object_id_t npu_id = sai_uoid_npu_obj_id_get (id);
+
+    if ((id == SAI_NULL_OBJECT_ID) || (npu_id >= SAI_BRIDGE_DB_DENSE_MAX)) {
+        return false;
+    }
+
+    *index = (uint32_t) npu_id;
+    return true;
+}
+
+/*
+ * Order used by paged iteration: NPU object id, then the full id. Within a
+ * store all ids normally share an object type, so this is plain id order.
+ */
+static inline bool sai_bridge_db_id_less (sai_object_id_t lhs, sai_object_id_t rhs)
+{
+    sai_npu_object_id_t lhs_npu_id = sai_uoid_npu_obj_id_get (lhs);
+    sai_npu_object_id_t rhs_npu_id = sai_uoid_npu_obj_id_get (rhs);
+
+    return ((lhs_npu_id < rhs_npu_id) || ((lhs_npu_id == rhs_npu_id) && (lhs < rhs)));
+}
+
+static void *sai_bridge_db_aligned_calloc (size_t size)
+{
+    void *mem = NULL;
+
+    if (posix_memalign (&mem, SAI_BRIDGE_DB_CACHE_LINE_SIZE, size) != 0) {
+        return NULL;
+    }
+
+    memset (mem, 0, size);
+    return mem;
+}
+
+template <typename T>
+struct sai_bridge_db_t {
+    typedef sai_bridge_db_entry_t<T> entry_t;
+    typedef sai_bridge_db_slab_t<T>  slab_t;
+    typedef sai_bridge_db_node_t<T>  node_t;
+    typedef sai_bridge_db_table_t<T> table_t;
+
+    std::atomic<slab_t *>  slabs [SAI_BRIDGE_DB_SLAB_COUNT];
+    std::atomic<table_t *> table;
+    std::atomic<uint32_t>  size;
+    std_mutex_type_t       mutex;
+
+    /* Only accessed with the mutex held */
+    sai_epoch_retire_list_t retired;
+
+    sai_bridge_db_t () : table (NULL), size (0), retired () {
+        uint32_t idx;
+
+        for (idx = 0; idx < SAI_BRIDGE_DB_SLAB_COUNT; idx++) {
+            slabs [idx].store (NULL, std::memory_order_relaxed);
+        }
+        std_mutex_lock_init_non_recursive (&mutex);
+    }
+
+    /*
+     * Read-side section. Returns true if the thread read locked, false if
+     * it had to take the mutex instead. Pass the result to read_end.
+     */
+    bool read_begin (void) {
+        if (sai_epoch_read_lock ()) {
+            return true;
+        }
+        std_mutex_lock (&mutex);
+        return false;
+    }
+
+    void read_end (bool read_locked) {
+        if (read_locked) {
+            sai_epoch_read_unlock ();
+        }
+        else {
+            std_mutex_unlock (&mutex);
+        }
+    }
+
+    /* Slab slot of a dense id. Needs no read-side section. */
+    entry_t *dense_slot (uint32_t index) const {
+        slab_t *slab = slabs [index >> SAI_BRIDGE_DB_SLAB_BITS].load (std::memory_order_acquire);
+
+        if (slab == NULL) {
+            return NULL;
+        }
+        return &slab->entry [index & (SAI_BRIDGE_DB_SLAB_SIZE - 1)];
+    }
+
+    /* Called from a read-side section or with the mutex held */
+    entry_t *find (sai_object_id_t id) const {
+        const table_t *tbl;
+        const node_t  *node;
+        entry_t       *entry;
+        uint32_t       index;
+
+        if (sai_bridge_db_dense_index (id, &index)) {
+            entry = dense_slot (index);
+            if ((entry != NULL) && (entry->id.load (std::memory_order_acquire) == id)) {
+                return entry;
+            }
+        }
+
+        tbl = table.load (std::memory_order_acquire);
+        if (tbl == NULL) {
+            return NULL;
+        }
+
+        node = tbl->bucket [sai_bridge_db_hash (id) & tbl->mask].load (std::memory_order_acquire);
+        while (node != NULL) {
+            if (node->id == id) {
+                return node->entry;
+            }
+            node = node->next.load (std::memory_order_acquire);
+        }
+
+        return NULL;
+    }
+
+    /*
+     * Copies out a consistent entry. Returns false if the entry no longer
+     * holds 'id', as a slab slot may be freed under the reader.
+     */
+    static bool snapshot (const entry_t *entry, sai_object_id_t id, T *info) {
+        uint32_t seq;
+        uint32_t spin = 0;
+        bool     found;
+
+        do {
+            while ((seq = entry->seq.load (std::memory_order_acquire)) & 1) {
+                /*
+                 * A cache write is copying the entry. Spin briefly, but let
+                 * the writer run if it got preempted mid-update.
+                 */
+                if (++spin >= SAI_BRIDGE_DB_READ_SPIN_MAX) {
+                    sched_yield ();
+                    spin = 0;
+                }
+            }
+            found = (entry->id.load (std::memory_order_relaxed) == id);
+            if (found) {
+                memcpy (info, &entry->info, sizeof (T));
+            }
+            std::atomic_thread_fence (std::memory_order_acquire);
+        } while (entry->seq.load (std::memory_order_relaxed) != seq);
+
+        return found;
+    }
+
+    /* Updates an entry under its sequence counter. Mutex must be held. */
+    static void entry_update (entry_t *entry, sai_object_id_t id, const T *info) {
+        entry->seq.store (entry->seq.load (std::memory_order_relaxed) + 1,
+                          std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        if (info != NULL) {
+            memmove (&entry->info, info, sizeof (T));
+        }
+        entry->id.store (id, std::memory_order_relaxed);
+
+        entry->seq.store (entry->seq.load (std::memory_order_relaxed) + 1,
+                          std::memory_order_release);
+    }
+
+    /* Must be called with the mutex held, after the object is unlinked */
+    void retire (void *mem, sai_epoch_obj_t *obj) {
+        sai_epoch_retire (&retired, obj, mem);
+    }
+
+    void retire (void *ptr) {
+        retire (ptr, (sai_epoch_obj_t *) ptr);
+    }
+
+    static table_t *table_alloc (uint32_t bucket_count) {
+        return (table_t *) calloc (1, sizeof (table_t) +
+                                   (bucket_count - 1) * sizeof (std::atomic<node_t *>));
+    }
+
+    static node_t *node_alloc (sai_object_id_t id, entry_t *entry) {
+        node_t *node = (node_t *) calloc (1, sizeof (node_t));
+
+        if (node != NULL) {
+            node->id    = id;
+            node->entry = entry;
+        }
+        return node;
+    }
+
+    static void node_link (table_t *tbl, node_t *node) {
+        std::atomic<node_t *> *head = &tbl->bucket [sai_bridge_db_hash (node->id) & tbl->mask];
+
+        node->next.store (head->load (std::memory_order_relaxed), std::memory_order_relaxed);
+        head->store (node, std::memory_order_release);
+    }
+
+    /*
+     * Makes room for one more hashed entry. Readers keep walking the old
+     * buckets and nodes, which are copied rather than relinked, and retired.
+     * Must be called with the mutex held.
+     */
+    sai_status_t reserve (void) {
+        table_t  *tbl = table.load (std::memory_order_relaxed);
+        table_t  *new_tbl;
+        node_t   *node;
+        node_t   *copy;
+        uint32_t  bucket_count;
+        uint32_t  idx;
+
+        if ((tbl != NULL) && (size.load (std::memory_order_relaxed) <= tbl->mask)) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        bucket_count = (tbl == NULL) ? SAI_BRIDGE_DB_MIN_BUCKETS : 2 * (tbl->mask + 1);
+        new_tbl      = table_alloc (bucket_count);
+
+        if (new_tbl == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+        new_tbl->mask = bucket_count - 1;
+
+        if (tbl != NULL) {
+            for (idx = 0; idx <= tbl->mask; idx++) {
+                for (node = tbl->bucket [idx].load (std::memory_order_relaxed); node != NULL;
+                     node = node->next.load (std::memory_order_relaxed)) {
+                    copy = node_alloc (node->id, node->entry);
+                    if (copy == NULL) {
+                        table_free (new_tbl);
+                        return SAI_STATUS_NO_MEMORY;
+                    }
+                    node_link (new_tbl, copy);
+                }
+            }
+        }
+
+        table.store (new_tbl, std::memory_order_release);
+
+        if (tbl != NULL) {
+            for (idx = 0; idx <= tbl->mask; idx++) {
+                node = tbl->bucket [idx].load (std::memory_order_relaxed);
+                while (node != NULL) {
+                    copy = node->next.load (std::memory_order_relaxed);
+                    retire (node);
+                    node = copy;
+                }
+            }
+            retire (tbl);
+        }
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /* Frees a table that was never published, along with its nodes */
+    static void table_free (table_t *tbl) {
+        node_t   *node;
+        node_t   *next;
+        uint32_t  idx;
+
+        for (idx = 0; idx <= tbl->mask; idx++) {
+            node = tbl->bucket [idx].load (std::memory_order_relaxed);
+            while (node != NULL) {
+                next = node->next.load (std::memory_order_relaxed);
+                free (node);
+                node = next;
+            }
+        }
+        free (tbl);
+    }
+
+    /*
+     * Returns the free slab slot for a dense id, allocating its slab on
+     * first use, or NULL if the id has to be hashed. Mutex must be held.
+     */
+    entry_t *dense_alloc (sai_object_id_t id, sai_status_t *rc) {
+        std::atomic<slab_t *> *slab_ptr;
+        slab_t                *slab;
+        entry_t               *entry;
+        uint32_t               index;
+
+        *rc = SAI_STATUS_SUCCESS;
+
+        if (!sai_bridge_db_dense_index (id, &index)) {
+            return NULL;
+        }
+
+        slab_ptr = &slabs [index >> SAI_BRIDGE_DB_SLAB_BITS];
+        slab     = slab_ptr->load (std::memory_order_relaxed);
+
+        if (slab == NULL) {
+            slab = (slab_t *) sai_bridge_db_aligned_calloc (sizeof (slab_t));
+            if (slab == NULL) {
+                *rc = SAI_STATUS_NO_MEMORY;
+                return NULL;
+            }
+            slab_ptr->store (slab, std::memory_order_release);
+        }
+
+        entry = &slab->entry [index & (SAI_BRIDGE_DB_SLAB_SIZE - 1)];
+
+        /* Slot already holds an object of the same NPU id but another type */
+        if (entry->id.load (std::memory_order_relaxed) != SAI_NULL_OBJECT_ID) {
+            return NULL;
+        }
+
+        return entry;
+    }
+
+    /* Returns true if the entry lives in a slab rather than the hash table */
+    bool is_dense_entry (sai_object_id_t id, const entry_t *entry) const {
+        uint32_t index;
+
+        return (sai_bridge_db_dense_index (id, &index) && (dense_slot (index) == entry));
+    }
+
+    /* Must be called with the mutex held */
+    sai_status_t write (sai_object_id_t id, const T *info) {
+        entry_t      *entry = find (id);
+        node_t       *node;
+        sai_status_t  rc;
+
+        if (entry != NULL) {
+            entry_update (entry, id, info);
+            return SAI_STATUS_SUCCESS;
+        }
+
+        entry = dense_alloc (id, &rc);
+        if (rc != SAI_STATUS_SUCCESS) {
+            return rc;
+        }
+
+        if (entry != NULL) {
+            entry_update (entry, id, info);
+            size.fetch_add (1, std::memory_order_relaxed);
+            return SAI_STATUS_SUCCESS;
+        }
+
+        rc = reserve ();
+        if (rc != SAI_STATUS_SUCCESS) {
+            return rc;
+        }
+
+        entry = (entry_t *) sai_bridge_db_aligned_calloc (sizeof (entry_t));
+        node  = node_alloc (id, entry);
+
+        if ((entry == NULL) || (node == NULL)) {
+            free (entry);
+            free (node);
+            return SAI_STATUS_NO_MEMORY;
+        }
+        entry->info = *info;
+        entry->id.store (id, std::memory_order_relaxed);
+
+        node_link (table.load (std::memory_order_relaxed), node);
+        size.fetch_add (1, std::memory_order_relaxed);
+
+        if (retired.count >= SAI_BRIDGE_DB_RECLAIM_THRESHOLD) {
+            sai_epoch_reclaim (&retired);
+        }
+
+        return SAI_STATUS_SUCCESS;
+    }
+
+    /* Must be called with the mutex held */
+    void erase (sai_object_id_t id) {
+        table_t               *tbl = table.load (std::memory_order_relaxed);
+        std::atomic<node_t *> *link;
+        node_t                *node;
+        entry_t               *entry = find (id);
+
+        if (entry == NULL) {
+            return;
+        }
+
+        if (is_dense_entry (id, entry)) {
+            entry_update (entry, SAI_NULL_OBJECT_ID, NULL);
+            size.fetch_sub (1, std::memory_order_relaxed);
+            return;
+        }
+
+        link = &tbl->bucket [sai_bridge_db_hash (id) & tbl->mask];
+        while ((node = link->load (std::memory_order_relaxed)) != NULL) {
+            if (node->id == id) {
+                link->store (node->next.load (std::memory_order_relaxed),
+                             std::memory_order_release);
+                retire (node->entry, &node->entry->hdr);
+                retire (node);
+                size.fetch_sub (1, std::memory_order_relaxed);
+                break;
+            }
+            link = &node->next;
+        }
+
+        if (retired.count >= SAI_BRIDGE_DB_RECLAIM_THRESHOLD) {
+            sai_epoch_reclaim (&retired);
+        }
+    }
+
+    /*
+     * Fills 'id_list' with up to 'count' ids and returns how many there
+     * were in total. Dense ids come first, in NPU id order. Called from a
+     * read-side section or with the mutex held.
+     */
+    uint_t list (uint_t count, sai_object_id_t *id_list) const {
+        const table_t   *tbl;
+        const node_t    *node;
+        const slab_t    *slab;
+        sai_object_id_t  id;
+        uint_t           idx = 0;
+        uint32_t         slab_idx;
+        uint32_t         slot;
+        uint32_t         bucket;
+
+        for (slab_idx = 0; slab_idx < SAI_BRIDGE_DB_SLAB_COUNT; slab_idx++) {
+            slab = slabs [slab_idx].load (std::memory_order_acquire);
+            if (slab == NULL) {
+                continue;
+            }
+            for (slot = 0; slot < SAI_BRIDGE_DB_SLAB_SIZE; slot++) {
+                id = slab->entry [slot].id.load (std::memory_order_acquire);
+                if (id == SAI_NULL_OBJECT_ID) {
+                    continue;
+                }
+                if (idx < count) {
+                    id_list [idx] = id;
+                }
+                idx++;
+            }
+        }
+
+        tbl = table.load (std::memory_order_acquire);
+        if (tbl == NULL) {
+            return idx;
+        }
+
+        for (bucket = 0; bucket <= tbl->mask; bucket++) {
+            for (node = tbl->bucket [bucket].load (std::memory_order_acquire); node != NULL;
+                 node = node->next.load (std::memory_order_acquire)) {
+                if (idx < count) {
+                    id_list [idx] = node->id;
+                }
+                idx++;
+            }
+        }
+
+        return idx;
+    }
+
+    /*
+     * Fills 'id_list' with the first 'count' ids that order after
+     * 'start_after' and returns how many were filled. Slabs are already in
+     * NPU id order; hashed ids are merged in. Called from a read-side
+     * section or with the mutex held.
+     */
+    uint_t page (sai_object_id_t start_after, uint_t count, sai_object_id_t *id_list) const {
+        sai_npu_object_id_t  start_npu_id = sai_uoid_npu_obj_id_get (start_after);
+        const table_t       *tbl;
+        const node_t        *node;
+        const slab_t        *slab;
+        sai_object_id_t      id;
+        uint_t               idx = 0;
+        uint_t               pos;
+        uint32_t             index;
+        uint32_t             bucket;
+
+        for (index = (start_npu_id < SAI_BRIDGE_DB_DENSE_MAX) ? (uint32_t) start_npu_id :
+                     SAI_BRIDGE_DB_DENSE_MAX;
+             (index < SAI_BRIDGE_DB_DENSE_MAX) && (idx < count); index++) {
+            slab = slabs [index >> SAI_BRIDGE_DB_SLAB_BITS].load (std::memory_order_acquire);
+            if (slab == NULL) {
+                index |= (SAI_BRIDGE_DB_SLAB_SIZE - 1);
+                continue;
+            }
+            id = slab->entry [index & (SAI_BRIDGE_DB_SLAB_SIZE - 1)].id.load (
+                                                                std::memory_order_acquire);
+            if ((id != SAI_NULL_OBJECT_ID) && sai_bridge_db_id_less (start_after, id)) {
+                id_list [idx++] = id;
+            }
+        }
+
+        tbl = table.load (std::memory_order_acquire);
+        if ((tbl == NULL) || (count == 0)) {
+            return idx;
+        }
+
+        for (bucket = 0; bucket <= tbl->mask; bucket++) {
+            for (node = tbl->bucket [bucket].load (std::memory_order_acquire); node != NULL;
+                 node = node->next.load (std::memory_order_acquire)) {
+                if (!sai_bridge_db_id_less (start_after, node->id)) {
+                    continue;
+                }
+                if (idx == count) {
+                    if (!sai_bridge_db_id_less (node->id, id_list [count - 1])) {
+                        continue;
+                    }
+                    idx--;
+                }
+                for (pos = idx; (pos > 0) && sai_bridge_db_id_less (node->id, id_list [pos - 1]);
+                     pos--) {
+                    id_list [pos] = id_list [pos - 1];
+                }
+                id_list [pos] = node->id;
+                idx++;
+            }
+        }
+
+        return idx;
+    }
+};
+
+static sai_bridge_db_t<dn_sai_bridge_info_t>      bridge_db;
+static sai_bridge_db_t<dn_sai_bridge_port_info_t> bridge_port_db;
+
+template <typename T>
+static sai_status_t sai_bridge_db_get (sai_bridge_db_t<T> *db, sai_object_id_t id, T *info)
+{
+    sai_bridge_db_entry_t<T> *entry;
+    bool                      read_locked;
+
+    bool                      found = false;
+    uint32_t                  index;
+
+    /* Slabs are never freed, so dense ids are read without a read-side section */
+    if (sai_bridge_db_dense_index (id, &index)) {
+        entry = db->dense_slot (index);
+        if ((entry != NULL) && sai_bridge_db_t<T>::snapshot (entry, id, info)) {
+            return SAI_STATUS_SUCCESS;
+        }
+    }
+
+    read_locked = db->read_begin ();
+
+    entry = db->find (id);
+    if (entry != NULL) {
+        found = sai_bridge_db_t<T>::snapshot (entry, id, info);
+    }
+
+    db->read_end (read_locked);
+
+    return found ? SAI_STATUS_SUCCESS : SAI_STATUS_INVALID_OBJECT_ID;
+}
+
+template <typename T>
+static bool sai_bridge_db_contains (sai_bridge_db_t<T> *db, sai_object_id_t id)
+{
+    sai_bridge_db_entry_t<T> *entry;
+    bool                      found;
+    bool                      read_locked;
+    uint32_t                  index;
+
+    if (sai_bridge_db_dense_index (id, &index)) {
+        entry = db->dense_slot (index);
+        if ((entry != NULL) && (entry->id.load (std::memory_order_acquire) == id)) {
+            return true;
+        }
+    }
+
+    read_locked = db->read_begin ();
+    found = (db->find (id) != NULL);
+    db->read_end (read_locked);
+
+    return found;
+}
+
+template <typename T>
+static sai_status_t sai_bridge_db_list_get (sai_bridge_db_t<T> *db, uint_t *count,
+                                            sai_object_id_t *id_list)
+{
+    uint_t total;
+    bool   read_locked;
+
+    read_locked = db->read_begin ();
+    total = db->list (*count, id_list);
+    db->read_end (read_locked);
+
+    if (total > *count) {
+        SAI_BRIDGE_LOG_ERR("Expected %d count but actual count is %d", total, *count);
+        *count = total;
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    *count = total;
+    return SAI_STATUS_SUCCESS;
+}
+
+template <typename T>
+static void sai_bridge_db_page_get (sai_bridge_db_t<T> *db, sai_object_id_t start_after,
+                                    uint_t *count, sai_object_id_t *id_list)
+{
+    bool read_locked;
+
+    read_locked = db->read_begin ();
+    *count = db->page (start_after, *count, id_list);
+    db->read_end (read_locked);
+}
+
+/*
+ * Secondary indexes on bridge ports, kept as sai_map relations so that
+ * they are read without the bridge lock like the cache itself:
+ *
+ *   {bridge_id, tunnel_id} --> tunnel bridge ports
+ *   {lag_id}               --> port bridge ports attached to the LAG
+ *   {bridge_port_type}     --> bridge ports of that type
+ *
+ * They are updated with the bridge port store mutex held. The type and
+ * attachment of a bridge port never change, only its bridge can.
+ */
+static inline sai_map_oid_key_t sai_bridge_port_type_index_key (const dn_sai_bridge_port_info_t
+                                                                *info)
+{
+    sai_map_oid_key_t key = {(sai_object_id_t) info->bridge_port_type};
+    return key;
+}
+
+static inline sai_map_oid_pair_key_t sai_bridge_port_tunnel_index_key (
+                                                    const dn_sai_bridge_port_info_t *info)
+{
+    sai_map_oid_pair_key_t key = {info->bridge_id, sai_bridge_port_info_get_tunnel_id(info)};
+    return key;
+}
+
+static inline bool sai_bridge_port_info_is_lag (const dn_sai_bridge_port_info_t *info)
+{
+    return ((info->bridge_port_type == SAI_BRIDGE_PORT_TYPE_PORT) &&
+            sai_is_obj_id_lag (sai_bridge_port_info_get_port_id(info)));
+}
+
+static void sai_bridge_port_index_remove (const dn_sai_bridge_port_info_t *info)
+{
+    sai_map_oid_val_t val = {info->bridge_port_id};
+
+    sai_bridge_port_type_relation_t::remove (sai_bridge_port_type_index_key (info), val);
+
+    if (sai_bridge_port_info_is_lag (info)) {
+        sai_map_oid_key_t key = {sai_bridge_port_info_get_port_id(info)};
+
+        sai_lag_port_bridge_port_relation_t::remove (key, val);
+    }
+    else if (info->bridge_port_type == SAI_BRIDGE_PORT_TYPE_TUNNEL) {
+        sai_bridge_tunnel_bridge_port_relation_t::remove (sai_bridge_port_tunnel_index_key (info),
+                                                          val);
+    }
+}
+
+static sai_status_t sai_bridge_port_index_add (const dn_sai_bridge_port_info_t *info)
+{
+    sai_map_oid_val_t val = {info->bridge_port_id};
+    sai_status_t      rc;
+
+    rc = sai_bridge_port_type_relation_t::insert (sai_bridge_port_type_index_key (info), val);
+
+    if ((rc == SAI_STATUS_SUCCESS) && sai_bridge_port_info_is_lag (info)) {
+        sai_map_oid_key_t key = {sai_bridge_port_info_get_port_id(info)};
+
+        rc = sai_lag_port_bridge_port_relation_t::insert (key, val);
+    }
+    else if ((rc == SAI_STATUS_SUCCESS) &&
+             (info->bridge_port_type == SAI_BRIDGE_PORT_TYPE_TUNNEL)) {
+        rc = sai_bridge_tunnel_bridge_port_relation_t::insert (
+                                            sai_bridge_port_tunnel_index_key (info), val);
+    }
+
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_BRIDGE_LOG_ERR("Error %d in bridge port 0x%" PRIx64 " index insert",
+                           rc, info->bridge_port_id);
+        sai_bridge_port_index_remove (info);
+    }
+
+    return rc;
+}
+
+/*
+ * Moves a tunnel bridge port that changed bridge. The previous bridge is
+ * taken from the index itself, as the caller may have updated the cached
+ * entry in place before writing it back.
+ */
+static sai_status_t sai_bridge_port_index_update (const dn_sai_bridge_port_info_t *info)
+{
+    sai_map_oid_pair_key_t new_key;
+    sai_map_oid_pair_key_t old_key = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+    sai_map_oid_val_t      val = {info->bridge_port_id};
+    sai_status_t           rc;
+
+    if (info->bridge_port_type != SAI_BRIDGE_PORT_TYPE_TUNNEL) {
+        return SAI_STATUS_SUCCESS;
+    }
 
-static std::unordered_map<sai_object_id_t, dn_sai_bridge_info_t> bridge_db;
-static std::unordered_map<sai_object_id_t, dn_sai_bridge_port_info_t> bridge_port_db;
+    new_key = sai_bridge_port_tunnel_index_key (info);
+
+    rc = sai_bridge_tunnel_bridge_port_relation_t::reverse_get (info->bridge_port_id, &old_key);
+    if ((rc == SAI_STATUS_SUCCESS) &&
+        (old_key.id1 == new_key.id1) && (old_key.id2 == new_key.id2)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    rc = sai_bridge_tunnel_bridge_port_relation_t::insert (new_key, val);
+    if (rc != SAI_STATUS_SUCCESS) {
+        SAI_BRIDGE_LOG_ERR("Error %d in bridge port 0x%" PRIx64 " index update",
+                           rc, info->bridge_port_id);
+        return rc;
+    }
+
+    if ((old_key.id1 != SAI_NULL_OBJECT_ID) || (old_key.id2 != SAI_NULL_OBJECT_ID)) {
+        sai_bridge_tunnel_bridge_port_relation_t::remove (old_key, val);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
 
 extern "C" {
 
@@ -45,20 +839,13 @@ sai_status_t sai_bridge_cache_write (sai_object_id_t bridge_id, const dn_sai_bri
                              bridge_id);
         return SAI_STATUS_INVALID_PARAMETER;
     }
-    try {
-        auto map_it = bridge_db.find (bridge_id);
 
-        if (map_it != bridge_db.end()) {
-            dn_sai_bridge_info_t &cached_bridge_info = map_it->second;
-            cached_bridge_info = *bridge_info;
-        }
-        else {
-            bridge_db.insert (std::make_pair (bridge_id, *bridge_info));
-        }
-    }
-    catch (...) {
+    std_mutex_lock (&bridge_db.mutex);
+    rc = bridge_db.write (bridge_id, bridge_info);
+    std_mutex_unlock (&bridge_db.mutex);
+
+    if(rc != SAI_STATUS_SUCCESS) {
         SAI_BRIDGE_LOG_WARN("Error condition encountered in bridge cache write");
-        rc = SAI_STATUS_FAILURE;
     }
 
     return (rc);
@@ -66,123 +853,182 @@ sai_status_t sai_bridge_cache_write (sai_object_id_t bridge_id, const dn_sai_bri
 
 sai_status_t sai_bridge_cache_delete (sai_object_id_t bridge_id)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
-
-    try {
-        auto map_it = bridge_db.find (bridge_id);
-        if (map_it != bridge_db.end()) {
-            bridge_db.erase (map_it);
-        }
-    }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in bridge cache delete");
-        rc = SAI_STATUS_FAILURE;
-    }
+    std_mutex_lock (&bridge_db.mutex);
+    bridge_db.erase (bridge_id);
+    std_mutex_unlock (&bridge_db.mutex);
 
-    return rc;
+    return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_bridge_cache_read (sai_object_id_t bridge_id, dn_sai_bridge_info_t **bridge_info)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_bridge_db_entry_t<dn_sai_bridge_info_t> *entry;
+    bool                                         read_locked;
 
     if(bridge_info == NULL) {
         SAI_BRIDGE_LOG_TRACE("NULL *bridge_port_info passed in bridge cache read");
         return SAI_STATUS_INVALID_PARAMETER;
     }
-    try {
-        auto map_it = bridge_db.find (bridge_id);
-        if (map_it != bridge_db.end()) {
-            *bridge_info =(dn_sai_bridge_info_t *)&map_it->second;
-        }
-        else {
+
+    /* The entry is only stable, and only safe to hold, under the bridge lock */
+    STD_ASSERT(sai_bridge_is_locked());
+
+    read_locked = bridge_db.read_begin ();
+    entry = bridge_db.find (bridge_id);
+    bridge_db.read_end (read_locked);
+
+    if (entry == NULL) {
         SAI_BRIDGE_LOG_WARN("Error condition encountered in bridge cache read");
-            rc = SAI_STATUS_INVALID_OBJECT_ID;
-        }
-    }
-    catch (...) {
-        rc = SAI_STATUS_FAILURE;
+        return SAI_STATUS_INVALID_OBJECT_ID;
     }
 
-    return rc;
+    *bridge_info = &entry->info;
+
+    return SAI_STATUS_SUCCESS;
 }
 
-bool sai_is_bridge_created (sai_object_id_t bridge_id)
+sai_status_t sai_bridge_cache_entry_update (dn_sai_bridge_info_t *bridge_info,
+                                            const dn_sai_bridge_info_t *new_info)
 {
+    sai_bridge_db_entry_t<dn_sai_bridge_info_t> *entry;
+    bool                                         read_locked;
 
-    auto map_it = bridge_db.find (bridge_id);
+    if((bridge_info == NULL) || (new_info == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("NULL bridge info passed in bridge cache entry update");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
 
-    try {
-        if(map_it != bridge_db.end()) {
-            return true;
-        }
+    read_locked = bridge_db.read_begin ();
+    entry = bridge_db.find (bridge_info->bridge_id);
+    bridge_db.read_end (read_locked);
+
+    if ((entry == NULL) || (&entry->info != bridge_info)) {
+        /* A copy private to the caller, not visible to readers */
+        *bridge_info = *new_info;
+        return SAI_STATUS_SUCCESS;
     }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in is bridge created");
+
+    return sai_bridge_cache_write (bridge_info->bridge_id, new_info);
+}
+
+sai_status_t sai_bridge_cache_get (sai_object_id_t bridge_id, dn_sai_bridge_info_t *bridge_info)
+{
+    if(bridge_info == NULL) {
+        SAI_BRIDGE_LOG_TRACE("NULL bridge_info passed in bridge cache get");
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    return false;
+
+    return sai_bridge_db_get (&bridge_db, bridge_id, bridge_info);
+}
+
+bool sai_is_bridge_created (sai_object_id_t bridge_id)
+{
+    return sai_bridge_db_contains (&bridge_db, bridge_id);
 }
 
 sai_status_t sai_bridge_port_cache_write (sai_object_id_t bridge_port_id,
                                           const dn_sai_bridge_port_info_t *bridge_port_info)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_status_t    rc = SAI_STATUS_SUCCESS;
+    sai_object_id_t mapped_bridge_id = SAI_NULL_OBJECT_ID;
+    bool            map_updated = false;
+    bool            is_new;
 
     if(bridge_port_info == NULL) {
         SAI_BRIDGE_LOG_TRACE("Bridge port info is NULL for bridge port id 0x%" PRIx64 ""
                              " in bridge port cache write", bridge_port_id);
         return SAI_STATUS_INVALID_PARAMETER;
     }
-    try {
+
+    std_mutex_lock (&bridge_port_db.mutex);
+
+    /* Rewriting a bridge port only touches the bridge map if its bridge changed */
+    if ((sai_bridge_map_bridge_get (bridge_port_info->bridge_port_id, &mapped_bridge_id) !=
+         SAI_STATUS_SUCCESS) || (mapped_bridge_id != bridge_port_info->bridge_id)) {
         rc = sai_bridge_map_insert(bridge_port_info->bridge_id,
                                    bridge_port_info->bridge_port_id);
 
         if(rc != SAI_STATUS_SUCCESS) {
             SAI_BRIDGE_LOG_ERR("Error %d in bridge to bridge port map insert", rc);
+            std_mutex_unlock (&bridge_port_db.mutex);
             return rc;
         }
+        if (mapped_bridge_id != SAI_NULL_OBJECT_ID) {
+            sai_bridge_map_remove(mapped_bridge_id, bridge_port_info->bridge_port_id);
+        }
+        map_updated = true;
+    }
+
+    is_new = (bridge_port_db.find (bridge_port_id) == NULL);
 
-        auto map_it = bridge_port_db.find (bridge_port_id);
+    rc = bridge_port_db.write (bridge_port_id, bridge_port_info);
 
-        if (map_it != bridge_port_db.end()) {
-            dn_sai_bridge_port_info_t &cached_bridge_port_info = map_it->second;
-            cached_bridge_port_info = *bridge_port_info;
+    if(rc == SAI_STATUS_SUCCESS) {
+        if (is_new) {
+            rc = sai_bridge_port_index_add (bridge_port_info);
+            if (rc != SAI_STATUS_SUCCESS) {
+                bridge_port_db.erase (bridge_port_id);
+            }
         }
         else {
-            bridge_port_db.insert (std::make_pair (bridge_port_id, *bridge_port_info));
+            rc = sai_bridge_port_index_update (bridge_port_info);
         }
     }
-    catch (...) {
+
+    if((rc != SAI_STATUS_SUCCESS) && map_updated) {
         SAI_BRIDGE_LOG_WARN("Error condition encountered in bridge port cache write");
         sai_bridge_map_remove(bridge_port_info->bridge_id, bridge_port_info->bridge_port_id);
-        rc = SAI_STATUS_FAILURE;
     }
 
+    std_mutex_unlock (&bridge_port_db.mutex);
+
     return (rc);
 }
 
+sai_status_t sai_bridge_port_cache_entry_update (dn_sai_bridge_port_info_t *bridge_port_info,
+                                                 const dn_sai_bridge_port_info_t *new_info)
+{
+    sai_bridge_db_entry_t<dn_sai_bridge_port_info_t> *entry;
+    bool                                              read_locked;
+
+    if((bridge_port_info == NULL) || (new_info == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("NULL bridge port info passed in bridge port cache entry update");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    read_locked = bridge_port_db.read_begin ();
+    entry = bridge_port_db.find (bridge_port_info->bridge_port_id);
+    bridge_port_db.read_end (read_locked);
+
+    if ((entry == NULL) || (&entry->info != bridge_port_info)) {
+        /* A copy private to the caller, not visible to readers */
+        *bridge_port_info = *new_info;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    return sai_bridge_port_cache_write (bridge_port_info->bridge_port_id, new_info);
+}
+
 sai_status_t sai_bridge_port_cache_delete (sai_object_id_t bridge_port_id)
 {
     sai_status_t rc = SAI_STATUS_SUCCESS;
-    dn_sai_bridge_port_info_t cached_bridge_port_info;
-
-    try {
-        auto map_it = bridge_port_db.find (bridge_port_id);
-        if (map_it != bridge_port_db.end()) {
-            cached_bridge_port_info = map_it->second;
-            rc = sai_bridge_map_remove(cached_bridge_port_info.bridge_id, bridge_port_id);
-            if(rc != SAI_STATUS_SUCCESS) {
-                SAI_BRIDGE_LOG_ERR("Error %d in bridge to bridge port map remove", rc);
-                return rc;
-            }
-            bridge_port_db.erase (map_it);
+    sai_bridge_db_entry_t<dn_sai_bridge_port_info_t> *entry;
+
+    std_mutex_lock (&bridge_port_db.mutex);
+
+    entry = bridge_port_db.find (bridge_port_id);
+    if (entry != NULL) {
+        rc = sai_bridge_map_remove(entry->info.bridge_id, bridge_port_id);
+        if(rc != SAI_STATUS_SUCCESS) {
+            SAI_BRIDGE_LOG_ERR("Error %d in bridge to bridge port map remove", rc);
+        }
+        else {
+            sai_bridge_port_index_remove (&entry->info);
+            bridge_port_db.erase (bridge_port_id);
         }
     }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in bridge port cache delete");
-        sai_bridge_map_insert(cached_bridge_port_info.bridge_id, bridge_port_id);
-        rc = SAI_STATUS_FAILURE;
-    }
+
+    std_mutex_unlock (&bridge_port_db.mutex);
 
     return rc;
 }
@@ -190,107 +1036,127 @@ sai_status_t sai_bridge_port_cache_delete (sai_object_id_t bridge_port_id)
 sai_status_t sai_bridge_port_cache_read (sai_object_id_t bridge_port_id,
                                          dn_sai_bridge_port_info_t **bridge_port_info)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_bridge_db_entry_t<dn_sai_bridge_port_info_t> *entry;
+    bool                                              read_locked;
 
     if(bridge_port_info == NULL) {
         SAI_BRIDGE_LOG_TRACE("NULL *bridge_port_info passed in bridge port cache read");
         return SAI_STATUS_INVALID_PARAMETER;
     }
-    try {
-        auto map_it = bridge_port_db.find (bridge_port_id);
-        if (map_it != bridge_port_db.end()) {
-            *bridge_port_info =(dn_sai_bridge_port_info_t *) &map_it->second;
-        }
-        else {
-            rc = SAI_STATUS_INVALID_OBJECT_ID;
-        }
-    }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in bridge port cache read");
-        rc = SAI_STATUS_FAILURE;
+
+    /* The entry is only stable, and only safe to hold, under the bridge lock */
+    STD_ASSERT(sai_bridge_is_locked());
+
+    read_locked = bridge_port_db.read_begin ();
+    entry = bridge_port_db.find (bridge_port_id);
+    bridge_port_db.read_end (read_locked);
+
+    if (entry == NULL) {
+        return SAI_STATUS_INVALID_OBJECT_ID;
     }
 
-    return rc;
+    *bridge_port_info = &entry->info;
+
+    return SAI_STATUS_SUCCESS;
 }
 
-bool sai_is_bridge_port_created (sai_object_id_t bridge_port_id)
+sai_status_t sai_bridge_port_cache_get (sai_object_id_t bridge_port_id,
+                                        dn_sai_bridge_port_info_t *bridge_port_info)
 {
+    if(bridge_port_info == NULL) {
+        SAI_BRIDGE_LOG_TRACE("NULL bridge_port_info passed in bridge port cache get");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
 
-    auto map_it = bridge_port_db.find (bridge_port_id);
+    return sai_bridge_db_get (&bridge_port_db, bridge_port_id, bridge_port_info);
+}
 
-    try {
-        if(map_it != bridge_port_db.end()) {
-            return true;
-        }
+sai_status_t sai_bridge_port_cache_bulk_visit (uint_t                          count,
+                                               const sai_object_id_t          *bridge_port_list,
+                                               sai_bridge_port_cache_visit_fn  visit_fn,
+                                               void                           *ctx)
+{
+    sai_bridge_db_entry_t<dn_sai_bridge_port_info_t> *entry;
+    uint_t                                            idx;
+
+    if((bridge_port_list == NULL) || (visit_fn == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("bridge port list is %p visit fn is %p in bridge port cache "
+                             "bulk visit", bridge_port_list, visit_fn);
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in is bridge port created");
+
+    std_mutex_lock (&bridge_port_db.mutex);
+
+    for (idx = 0; idx < count; idx++) {
+        entry = bridge_port_db.find (bridge_port_list [idx]);
+        visit_fn (idx, (entry != NULL) ? &entry->info : NULL, ctx);
     }
-    return false;
+
+    std_mutex_unlock (&bridge_port_db.mutex);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+bool sai_is_bridge_port_created (sai_object_id_t bridge_port_id)
+{
+    return sai_bridge_db_contains (&bridge_port_db, bridge_port_id);
 }
 
 uint_t sai_bridge_total_count(void)
 {
-    return bridge_db.size();
+    return bridge_db.size.load (std::memory_order_relaxed);
 }
 
 uint_t sai_bridge_port_total_count(void)
 {
-    return bridge_port_db.size();
+    return bridge_port_db.size.load (std::memory_order_relaxed);
 }
 
 sai_status_t sai_bridge_list_get(uint_t *count, sai_object_id_t *bridge_list)
 {
-    uint_t idx = 0;
-
     if((count == NULL) || (bridge_list == NULL)) {
         SAI_BRIDGE_LOG_TRACE("count is %p bridge list is %p in bridge list get",
                              count, bridge_list);
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    if(*count < sai_bridge_total_count()) {
-        SAI_BRIDGE_LOG_ERR("Expected %d count but actual count is %d",
-                           sai_bridge_total_count(),*count);
-        return SAI_STATUS_BUFFER_OVERFLOW;
-    }
-    try {
-        for(auto map_it = bridge_db.begin(); map_it != bridge_db.end();map_it++) {
-            bridge_list[idx] = map_it->first;
-            idx++;
-        }
-    }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in is bridge list get");
-        return SAI_STATUS_FAILURE;
-    }
-    *count = idx;
-    return SAI_STATUS_SUCCESS;
+
+    return sai_bridge_db_list_get (&bridge_db, count, bridge_list);
 }
 
 sai_status_t sai_bridge_port_list_get(uint_t *count, sai_object_id_t *bridge_port_list)
 {
-    uint_t idx = 0;
-
     if((count == NULL) || (bridge_port_list == NULL)) {
         SAI_BRIDGE_LOG_TRACE("count is %p bridge port list is %p in bridge port list get",
                              count, bridge_port_list);
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    if(*count < sai_bridge_port_total_count()) {
-        SAI_BRIDGE_LOG_ERR("Expected %d count but actual count is %d",
-                           sai_bridge_port_total_count(),*count);
-        *count = sai_bridge_port_total_count();
-        return SAI_STATUS_BUFFER_OVERFLOW;
-    }
-    try {
-        for(auto map_it = bridge_port_db.begin(); map_it != bridge_port_db.end();map_it++) {
-            bridge_port_list[idx] = map_it->first;
-            idx++;
-        }
+
+    return sai_bridge_db_list_get (&bridge_port_db, count, bridge_port_list);
+}
+
+sai_status_t sai_bridge_list_page_get(sai_object_id_t start_after, uint_t *count,
+                                      sai_object_id_t *bridge_list)
+{
+    if((count == NULL) || (*count == 0) || (bridge_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("count is %p bridge list is %p in bridge list page get",
+                             count, bridge_list);
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    catch (...) {
-        SAI_BRIDGE_LOG_WARN("Error condition encountered in is bridge port list get");
-        return SAI_STATUS_FAILURE;
+
+    sai_bridge_db_page_get (&bridge_db, start_after, count, bridge_list);
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_bridge_port_list_page_get(sai_object_id_t start_after, uint_t *count,
+                                           sai_object_id_t *bridge_port_list)
+{
+    if((count == NULL) || (*count == 0) || (bridge_port_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("count is %p bridge port list is %p in bridge port list page get",
+                             count, bridge_port_list);
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    *count = idx;
+
+    sai_bridge_db_page_get (&bridge_port_db, start_after, count, bridge_port_list);
     return SAI_STATUS_SUCCESS;
 }
 
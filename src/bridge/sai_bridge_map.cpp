@@ -0,0 +1,593 @@
+/*
+ * Copyright (c) 2017 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sai_bridge_map.cpp
+ *
+ * Bridge module relations between bridges, bridge ports and the objects
+ * attached to them, built on the typed sai_map relations.
+ */
+
+#include "std_mutex_lock.h"
+#include "sai_map_relation.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "saibridge.h"
+#include "sai_bridge_api.h"
+#include "sai_bridge_common.h"
+
+static inline sai_map_oid_key_t sai_bridge_oid_key (sai_object_id_t id)
+{
+    sai_map_oid_key_t key = {id};
+    return key;
+}
+
+static inline sai_map_oid_pair_key_t sai_bridge_port_vlan_key (sai_object_id_t port_id,
+                                                               sai_vlan_id_t vlan_id)
+{
+    sai_map_oid_pair_key_t key = {port_id, vlan_id};
+    return key;
+}
+
+static inline sai_map_oid_val_t sai_bridge_oid_val (sai_object_id_t id)
+{
+    sai_map_oid_val_t val = {id};
+    return val;
+}
+
+/*
+ * Removes one element of an object keyed relation, dropping the key along
+ * with its last element.
+ */
+template <typename Relation>
+static inline sai_status_t sai_bridge_relation_remove (sai_object_id_t id, sai_object_id_t val1)
+{
+    return Relation::remove (sai_bridge_oid_key (id), sai_bridge_oid_val (val1));
+}
+
+/* List get of an object keyed relation. A missing key is an empty list. */
+template <typename Relation>
+static inline sai_status_t sai_bridge_relation_list_get (sai_object_id_t  id,
+                                                         uint_t          *count,
+                                                         sai_object_id_t *val1_list)
+{
+    sai_status_t rc;
+
+    rc = Relation::val1_list (sai_bridge_oid_key (id), count, val1_list);
+
+    if(rc == SAI_STATUS_ITEM_NOT_FOUND) {
+        *count = 0;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    return rc;
+}
+
+/* Count get of an object keyed relation. A missing key has no elements. */
+template <typename Relation>
+static inline sai_status_t sai_bridge_relation_count_get (sai_object_id_t  id,
+                                                          uint_t          *p_out_count)
+{
+    sai_status_t rc;
+
+    rc = Relation::count (sai_bridge_oid_key (id), p_out_count);
+
+    if(rc == SAI_STATUS_ITEM_NOT_FOUND) {
+        *p_out_count = 0;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    return rc;
+}
+
+/* Bulk insert of an object keyed relation from parallel id lists */
+template <typename Relation>
+static sai_status_t sai_bridge_relation_bulk_insert (uint32_t                count,
+                                                     const sai_object_id_t  *id_list,
+                                                     const sai_object_id_t  *val1_list,
+                                                     sai_status_t           *status_list)
+{
+    if((count == 0) || (id_list == NULL) || (val1_list == NULL) || (status_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Invalid input in bridge relation bulk insert");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return Relation::bulk_insert (count,
+                                  [id_list] (uint32_t idx) {
+                                      return sai_bridge_oid_key (id_list [idx]);
+                                  },
+                                  [val1_list] (uint32_t idx) {
+                                      return sai_bridge_oid_val (val1_list [idx]);
+                                  },
+                                  status_list);
+}
+
+extern "C" {
+
+sai_status_t sai_bridge_map_bulk_insert (uint32_t                count,
+                                         const sai_object_id_t  *bridge_id_list,
+                                         const sai_object_id_t  *bridge_port_list,
+                                         sai_status_t           *status_list)
+{
+    return sai_bridge_relation_bulk_insert<sai_bridge_bridge_port_relation_t> (count,
+                                                                               bridge_id_list,
+                                                                               bridge_port_list,
+                                                                               status_list);
+}
+
+sai_status_t sai_bridge_map_insert (sai_object_id_t bridge_id, sai_object_id_t bridge_port_id)
+{
+    return sai_bridge_bridge_port_relation_t::insert (sai_bridge_oid_key (bridge_id),
+                                                      sai_bridge_oid_val (bridge_port_id));
+}
+
+sai_status_t sai_bridge_map_remove (sai_object_id_t bridge_id, sai_object_id_t bridge_port_id)
+{
+    sai_bridge_relation_remove<sai_bridge_bridge_port_relation_t> (bridge_id, bridge_port_id);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_bridge_map_port_list_get (sai_object_id_t  bridge_id,
+                                           uint_t          *count,
+                                           sai_object_id_t *bridge_port_list)
+{
+    if((count == NULL) || (bridge_port_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Error count is %p bridge_port_list is %p for bridge id 0x%" PRIx64 ""
+                             " in bridge map port list get",count, bridge_port_list, bridge_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_list_get<sai_bridge_bridge_port_relation_t> (bridge_id, count,
+                                                                            bridge_port_list);
+}
+
+sai_status_t sai_bridge_map_get_port_count (sai_object_id_t  bridge_id,
+                                            uint_t        *p_out_count)
+{
+    if(p_out_count == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Error count is NULL for bridge id 0x%" PRIx64 ""
+                             " in bridge map port count get", bridge_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_bridge_port_relation_t::count (sai_bridge_oid_key (bridge_id), p_out_count);
+}
+
+sai_status_t sai_bridge_map_bridge_get (sai_object_id_t  bridge_port_id,
+                                        sai_object_id_t *bridge_id)
+{
+    sai_map_oid_key_t key;
+    sai_status_t      rc;
+
+    if(bridge_id == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Error bridge id is NULL for bridge port id 0x%" PRIx64 ""
+                             " in bridge map bridge get", bridge_port_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* A bridge port belongs to a single bridge */
+    rc = sai_bridge_bridge_port_relation_t::reverse_get (bridge_port_id, &key);
+
+    if(rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    *bridge_id = key.id;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_bridge_port_vlan_to_bridge_port_map_insert (sai_object_id_t port_id,
+                                                             sai_vlan_id_t vlan_id,
+                                                             sai_object_id_t bridge_port_id)
+{
+    return sai_port_vlan_bridge_port_relation_t::insert (sai_bridge_port_vlan_key (port_id,
+                                                                                   vlan_id),
+                                                         sai_bridge_oid_val (bridge_port_id));
+}
+
+sai_status_t sai_bridge_port_vlan_to_bridge_port_map_bulk_insert (uint32_t                count,
+                                                                  const sai_object_id_t  *port_list,
+                                                                  const sai_vlan_id_t    *vlan_list,
+                                                                  const sai_object_id_t  *bridge_port_list,
+                                                                  sai_status_t           *status_list)
+{
+    if((count == 0) || (port_list == NULL) || (vlan_list == NULL) ||
+       (bridge_port_list == NULL) || (status_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Invalid input in port vlan to bridge port bulk insert");
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_port_vlan_bridge_port_relation_t::bulk_insert (count,
+                                  [port_list, vlan_list] (uint32_t idx) {
+                                      return sai_bridge_port_vlan_key (port_list [idx],
+                                                                       vlan_list [idx]);
+                                  },
+                                  [bridge_port_list] (uint32_t idx) {
+                                      return sai_bridge_oid_val (bridge_port_list [idx]);
+                                  },
+                                  status_list);
+}
+
+bool sai_bridge_is_bridge_sub_port_duplicate(sai_object_id_t port_id, sai_vlan_id_t vlan_id)
+{
+    sai_map_oid_val_t val;
+
+    if((sai_port_vlan_bridge_port_relation_t::get (sai_bridge_port_vlan_key (port_id, vlan_id),
+                                                   &val) == SAI_STATUS_SUCCESS) &&
+       (val.val1 != SAI_NULL_OBJECT_ID)) {
+        return true;
+    }
+    return false;
+}
+
+sai_status_t sai_bridge_port_vlan_to_bridge_port_map_remove (sai_object_id_t port_id,
+                                                             sai_vlan_id_t vlan_id)
+{
+    sai_port_vlan_bridge_port_relation_t::erase (sai_bridge_port_vlan_key (port_id, vlan_id));
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_lag_to_bridge_port_map_insert (sai_object_id_t lag_id,
+                                                sai_object_id_t bridge_port_id)
+{
+    return sai_lag_bridge_port_relation_t::insert (sai_bridge_oid_key (lag_id),
+                                                   sai_bridge_oid_val (bridge_port_id));
+}
+
+sai_status_t sai_lag_to_bridge_port_map_remove (sai_object_id_t lag_id,
+                                                sai_object_id_t bridge_port_id)
+{
+    sai_bridge_relation_remove<sai_lag_bridge_port_relation_t> (lag_id, bridge_port_id);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_lag_bridge_map_port_list_get (sai_object_id_t  lag_id,
+                                               uint_t          *count,
+                                               sai_object_id_t *bridge_port_list)
+{
+    if((count == NULL) || (bridge_port_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Error count is %p bridge_port_list is %p for lag id 0x%" PRIx64 ""
+                             " in lag map bridge port list get",count, bridge_port_list, lag_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_list_get<sai_lag_bridge_port_relation_t> (lag_id, count,
+                                                                         bridge_port_list);
+}
+
+sai_status_t sai_lag_map_get_bridge_port_count (sai_object_id_t  lag_id,
+                                                uint_t          *p_out_count)
+{
+    if(p_out_count == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Error count is NULL for lag id 0x%" PRIx64 ""
+                             " in lag map bridge port list get", lag_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_count_get<sai_lag_bridge_port_relation_t> (lag_id, p_out_count);
+}
+
+sai_status_t sai_bridge_port_to_vlan_member_map_insert (sai_object_id_t bridge_port_id,
+                                                        sai_object_id_t vlan_member_id)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    rc = sai_bridge_port_vlan_member_relation_t::insert (sai_bridge_oid_key (bridge_port_id),
+                                                         sai_bridge_oid_val (vlan_member_id));
+    if(rc == SAI_STATUS_SUCCESS) {
+        sai_bridge_port_increment_ref_count(bridge_port_id);
+    }
+    return rc;
+}
+
+sai_status_t sai_bridge_port_to_vlan_member_map_remove (sai_object_id_t bridge_port_id,
+                                                        sai_object_id_t vlan_member_id)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    rc = sai_bridge_relation_remove<sai_bridge_port_vlan_member_relation_t> (bridge_port_id,
+                                                                             vlan_member_id);
+    if(rc == SAI_STATUS_SUCCESS) {
+        sai_bridge_port_decrement_ref_count(bridge_port_id);
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_bridge_port_to_vlan_member_list_get (sai_object_id_t  bridge_port_id,
+                                                      uint_t          *count,
+                                                      sai_object_id_t *vlan_member_list)
+{
+    if((count == NULL) || (vlan_member_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Error count is %p vlan_member_list is %p for bridge port id "
+                             " 0x%" PRIx64 " in bridge port vlan member list get",
+                             count, vlan_member_list, bridge_port_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_list_get<sai_bridge_port_vlan_member_relation_t> (bridge_port_id,
+                                                                                 count,
+                                                                                 vlan_member_list);
+}
+
+sai_status_t sai_bridge_port_to_vlan_member_count_get(sai_object_id_t  bridge_port_id,
+                                                      uint_t          *p_out_count)
+{
+    if(p_out_count == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Error count is NULL for bridge port id 0x%" PRIx64 ""
+                             " in bridge port vlan member count get", bridge_port_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_count_get<sai_bridge_port_vlan_member_relation_t> (bridge_port_id,
+                                                                                  p_out_count);
+}
+
+sai_status_t sai_bridge_port_to_stp_port_map_insert (sai_object_id_t bridge_port_id,
+                                                     sai_object_id_t stp_port_id)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    rc = sai_bridge_port_stp_port_relation_t::insert (sai_bridge_oid_key (bridge_port_id),
+                                                      sai_bridge_oid_val (stp_port_id));
+
+    if(rc == SAI_STATUS_SUCCESS) {
+        sai_bridge_port_increment_ref_count(bridge_port_id);
+    }
+    return rc;
+}
+
+sai_status_t sai_bridge_port_to_stp_port_map_remove (sai_object_id_t bridge_port_id,
+                                                     sai_object_id_t stp_port_id)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    rc = sai_bridge_relation_remove<sai_bridge_port_stp_port_relation_t> (bridge_port_id,
+                                                                          stp_port_id);
+
+    if(rc == SAI_STATUS_SUCCESS) {
+        sai_bridge_port_decrement_ref_count(bridge_port_id);
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_bridge_port_to_stp_port_list_get (sai_object_id_t  bridge_port_id,
+                                                   uint_t          *count,
+                                                   sai_object_id_t *stp_port_list)
+{
+    if((count == NULL) || (stp_port_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Error count is %p stp_port_list is %p for bridge port id "
+                             " 0x%" PRIx64 " in bridge port stp port list get",
+                             count, stp_port_list, bridge_port_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_list_get<sai_bridge_port_stp_port_relation_t> (bridge_port_id,
+                                                                              count,
+                                                                              stp_port_list);
+}
+
+sai_status_t sai_bridge_port_to_stp_port_count_get(sai_object_id_t  bridge_port_id,
+                                                   uint_t          *p_out_count)
+{
+    if(p_out_count == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Error count is NULL for bridge port id 0x%" PRIx64 ""
+                             " in bridge port stp port count get", bridge_port_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_count_get<sai_bridge_port_stp_port_relation_t> (bridge_port_id,
+                                                                               p_out_count);
+}
+
+sai_status_t sai_tunnel_to_bridge_port_map_insert (sai_object_id_t tunnel_id,
+                                                   sai_object_id_t bridge_port_id)
+{
+    return sai_tunnel_bridge_port_relation_t::insert (sai_bridge_oid_key (tunnel_id),
+                                                      sai_bridge_oid_val (bridge_port_id));
+}
+
+sai_status_t sai_tunnel_to_bridge_port_map_bulk_insert (uint32_t                count,
+                                                        const sai_object_id_t  *tunnel_list,
+                                                        const sai_object_id_t  *bridge_port_list,
+                                                        sai_status_t           *status_list)
+{
+    return sai_bridge_relation_bulk_insert<sai_tunnel_bridge_port_relation_t> (count,
+                                                                               tunnel_list,
+                                                                               bridge_port_list,
+                                                                               status_list);
+}
+
+sai_status_t sai_tunnel_to_bridge_port_map_remove (sai_object_id_t tunnel_id,
+                                                   sai_object_id_t bridge_port_id)
+{
+    sai_bridge_relation_remove<sai_tunnel_bridge_port_relation_t> (tunnel_id, bridge_port_id);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_tunnel_to_bridge_port_list_get (sai_object_id_t  tunnel_id,
+                                                 uint_t          *count,
+                                                 sai_object_id_t *bridge_port_list)
+{
+    if((count == NULL) || (bridge_port_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Error count is %p bridge_port_list is %p for tunnel id "
+                             " 0x%" PRIx64 " in tunnel bridge port list get",
+                             count, bridge_port_list, tunnel_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_list_get<sai_tunnel_bridge_port_relation_t> (tunnel_id, count,
+                                                                            bridge_port_list);
+}
+
+sai_status_t sai_tunnel_to_bridge_port_count_get(sai_object_id_t  tunnel_id,
+                                                 uint_t          *p_out_count)
+{
+    if(p_out_count == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Count is NULL for tunnel id 0x%" PRIx64 ""
+                             " in tunnel bridge port count get", tunnel_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_count_get<sai_tunnel_bridge_port_relation_t> (tunnel_id,
+                                                                             p_out_count);
+}
+
+sai_status_t sai_tunnel_to_bridge_port_get_at_index(sai_object_id_t tunnel_id,
+                                                    uint_t index,
+                                                    sai_object_id_t *bridge_port)
+{
+    sai_map_oid_val_t val;
+    sai_status_t      rc = SAI_STATUS_FAILURE;
+
+    if(bridge_port == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Bridge port is NULL for tunnel 0x%" PRIx64 " in "
+                             "tunnel to bridge port get at index", tunnel_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    rc = sai_tunnel_bridge_port_relation_t::get_at_index (sai_bridge_oid_key (tunnel_id), index,
+                                                          &val);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    *bridge_port = val.val1;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+bool sai_bridge_is_bridge_connected_to_tunnel(sai_object_id_t bridge_id,
+                                              sai_object_id_t tunnel_id)
+{
+    sai_map_oid_pair_key_t key = {bridge_id, tunnel_id};
+    uint32_t               count = 0;
+
+    /* Bridge and tunnel index kept by the bridge port cache */
+    if((sai_bridge_tunnel_bridge_port_relation_t::count (key, &count) == SAI_STATUS_SUCCESS) &&
+       (count > 0)) {
+        return true;
+    }
+    return false;
+}
+
+sai_status_t sai_bridge_port_list_get_by_lag (sai_object_id_t  lag_id,
+                                              uint_t          *count,
+                                              sai_object_id_t *bridge_port_list)
+{
+    if((count == NULL) || (bridge_port_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Error count is %p bridge_port_list is %p for lag id 0x%" PRIx64 ""
+                             " in bridge port list get by lag",count, bridge_port_list, lag_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_list_get<sai_lag_port_bridge_port_relation_t> (lag_id, count,
+                                                                              bridge_port_list);
+}
+
+sai_status_t sai_bridge_port_list_get_by_type (sai_bridge_port_type_t  bridge_port_type,
+                                               uint_t                 *count,
+                                               sai_object_id_t        *bridge_port_list)
+{
+    if((count == NULL) || (bridge_port_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Error count is %p bridge_port_list is %p for type %d"
+                             " in bridge port list get by type",count, bridge_port_list,
+                             bridge_port_type);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_list_get<sai_bridge_port_type_relation_t> (
+                                                    (sai_object_id_t) bridge_port_type,
+                                                    count, bridge_port_list);
+}
+
+sai_status_t sai_bridge_port_count_get_by_type (sai_bridge_port_type_t  bridge_port_type,
+                                                uint_t                 *p_out_count)
+{
+    if(p_out_count == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Error count is NULL for type %d in bridge port count get by type",
+                             bridge_port_type);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_count_get<sai_bridge_port_type_relation_t> (
+                                                    (sai_object_id_t) bridge_port_type,
+                                                    p_out_count);
+}
+
+sai_status_t sai_bridge_port_to_l2mc_member_map_insert (sai_object_id_t bridge_port_id,
+                                                        sai_object_id_t l2mc_member_id)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    rc = sai_bridge_port_l2mc_member_relation_t::insert (sai_bridge_oid_key (bridge_port_id),
+                                                         sai_bridge_oid_val (l2mc_member_id));
+    if(rc == SAI_STATUS_SUCCESS) {
+        sai_bridge_port_increment_ref_count(bridge_port_id);
+    }
+    return rc;
+}
+
+sai_status_t sai_bridge_port_to_l2mc_member_map_remove (sai_object_id_t bridge_port_id,
+                                                        sai_object_id_t l2mc_member_id)
+{
+    sai_status_t rc = SAI_STATUS_FAILURE;
+
+    rc = sai_bridge_relation_remove<sai_bridge_port_l2mc_member_relation_t> (bridge_port_id,
+                                                                             l2mc_member_id);
+    if(rc == SAI_STATUS_SUCCESS) {
+        sai_bridge_port_decrement_ref_count(bridge_port_id);
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_bridge_port_to_l2mc_member_list_get (sai_object_id_t  bridge_port_id,
+                                                      uint_t          *count,
+                                                      sai_object_id_t *l2mc_member_list)
+{
+    if((count == NULL) || (l2mc_member_list == NULL)) {
+        SAI_BRIDGE_LOG_TRACE("Error count is %p l2mc_member_list is %p for bridge port id "
+                             " 0x%" PRIx64 " in bridge port l2mc member list get",
+                             count, l2mc_member_list, bridge_port_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_list_get<sai_bridge_port_l2mc_member_relation_t> (bridge_port_id,
+                                                                                 count,
+                                                                                 l2mc_member_list);
+}
+
+sai_status_t sai_bridge_port_to_l2mc_member_count_get(sai_object_id_t  bridge_port_id,
+                                                      uint_t          *p_out_count)
+{
+    if(p_out_count == NULL) {
+        SAI_BRIDGE_LOG_TRACE("Error count is NULL for bridge port id 0x%" PRIx64 ""
+                             " in bridge port l2mc member count get", bridge_port_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_bridge_relation_count_get<sai_bridge_port_l2mc_member_relation_t> (bridge_port_id,
+                                                                                  p_out_count);
+}
+
+}
@@ -36,6 +36,7 @@
 
 #include "sai_port_common.h"
 #include "sai_port_utils.h"
+#include "sai_fdb_api.h"
 
 /* CPU ports attribute info cache */
 static sai_port_attr_info_t cpu_port_attr_info;
@@ -230,6 +231,7 @@ sai_status_t sai_port_attr_info_cache_set(sai_object_id_t port_id,
 
         case SAI_PORT_ATTR_MAX_LEARNED_ADDRESSES:
             port_attr_info->max_learned_address = attr->value.u32;
+            sai_fdb_port_learn_limit_set(port_id, attr->value.u32);
             break;
 
         case SAI_PORT_ATTR_FDB_LEARNING_LIMIT_VIOLATION_PACKET_ACTION:
@@ -38,6 +38,7 @@
 #include "std_assert.h"
 #include "std_mutex_lock.h"
 #include "std_struct_utils.h"
+#include "sai_ref_count.h"
 
 static std_mutex_lock_create_static_init_fast(port_lock);
 
@@ -925,42 +926,27 @@ sai_status_t sai_port_def_bridge_port_get (sai_object_id_t port, sai_object_id_t
 
 }
 
-sai_status_t sai_port_increment_ref_count (sai_object_id_t port)
+static bool sai_port_is_ref_count_obj_valid (sai_object_id_t port)
 {
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
-
-    if(port_info_table == NULL) {
-        return SAI_STATUS_ITEM_NOT_FOUND;
-    }
-    port_info_table->ref_count++;
-    return SAI_STATUS_SUCCESS;
+    return (sai_port_info_get(port) != NULL);
+}
 
+sai_status_t sai_port_increment_ref_count (sai_object_id_t port)
+{
+    return sai_ref_count_increment (port, sai_port_is_ref_count_obj_valid);
 }
 
 sai_status_t sai_port_decrement_ref_count (sai_object_id_t port)
 {
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
+    sai_status_t sai_rc = sai_ref_count_decrement (port);
 
-    if(port_info_table == NULL) {
-        return SAI_STATUS_ITEM_NOT_FOUND;
-    }
-    if(port_info_table->ref_count == 0) {
+    if((sai_rc == SAI_STATUS_ITEM_NOT_FOUND) && sai_port_is_ref_count_obj_valid (port)) {
         return SAI_STATUS_FAILURE;
     }
-    port_info_table->ref_count--;
-    return SAI_STATUS_SUCCESS;
-
+    return sai_rc;
 }
 
 bool sai_is_port_in_use (sai_object_id_t port)
 {
-    sai_port_info_t *port_info_table = sai_port_info_get(port);
-
-    if(port_info_table == NULL) {
-        return false;
-    }
-    if(port_info_table->ref_count > 0) {
-        return true;
-    }
-    return false;
+    return sai_ref_count_is_in_use (port);
 }
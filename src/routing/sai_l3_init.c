@@ -23,6 +23,7 @@
 #include "sai_l3_util.h"
 #include "sai_l3_api.h"
 #include "sai_switch_utils.h"
+#include "sai_map_utl.h"
 #include "saitypes.h"
 #include "saistatus.h"
 #include "std_mutex_lock.h"
@@ -136,6 +137,12 @@ sai_status_t sai_fib_global_init (void)
             break;
         }
 
+        /* Size the NH group map up front, it then never grows at run time */
+        if (sai_map_reserve (SAI_MAP_TYPE_NH_GRP_2_MEMBER_LIST,
+                             sai_switch_num_ecmp_groups_get ()) != SAI_STATUS_SUCCESS) {
+            SAI_ROUTER_LOG_WARN ("Failed to reserve the Next Hop Group map.");
+        }
+
         g_sai_fib_config.neighbor_mac_tree =
                       std_radix_create ("Neighbor_MAC_Tree",
                                         SAI_FIB_NEIGHBOR_MAC_ENTRY_TREE_KEY_LEN,
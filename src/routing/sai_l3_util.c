@@ -23,6 +23,7 @@
 #include "sai_l3_util.h"
 #include "sai_l3_common.h"
 #include "sai_oid_utils.h"
+#include "sai_ref_count.h"
 #include "sai_port_common.h"
 #include "sai_port_utils.h"
 #include "sairoute.h"
@@ -96,27 +97,22 @@ bool sai_fib_is_rif_created (sai_object_id_t rif_id)
 
 sai_status_t sai_rif_increment_ref_count (sai_object_id_t rif_id)
 {
-    sai_fib_router_interface_t *p_rif_node = sai_fib_router_interface_node_get(rif_id);
-
-    if(p_rif_node == NULL) {
-        return SAI_STATUS_ITEM_NOT_FOUND;
-    }
-    p_rif_node->ref_count++;
-    return SAI_STATUS_SUCCESS;
+    return sai_ref_count_increment (rif_id, sai_fib_is_rif_created);
 }
 
 sai_status_t sai_rif_decrement_ref_count (sai_object_id_t rif_id)
 {
-    sai_fib_router_interface_t *p_rif_node = sai_fib_router_interface_node_get(rif_id);
+    sai_status_t sai_rc = sai_ref_count_decrement (rif_id);
 
-    if(p_rif_node == NULL) {
-        return SAI_STATUS_ITEM_NOT_FOUND;
-    }
-    if(p_rif_node->ref_count == 0) {
+    if((sai_rc == SAI_STATUS_ITEM_NOT_FOUND) && sai_fib_is_rif_created (rif_id)) {
         return SAI_STATUS_FAILURE;
     }
-    p_rif_node->ref_count--;
-    return SAI_STATUS_SUCCESS;
+    return sai_rc;
+}
+
+bool sai_is_rif_in_use (sai_object_id_t rif_id)
+{
+    return sai_ref_count_is_in_use (rif_id);
 }
 sai_fib_vrf_t* sai_fib_get_vrf_node_for_rif (sai_object_id_t rif_id)
 {
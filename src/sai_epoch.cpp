@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2017 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sai_epoch.cpp
+ */
+
+#include "sai_epoch.h"
+#include <stdlib.h>
+
+sai_epoch_reader_t                  g_sai_epoch_readers [SAI_EPOCH_MAX_READERS];
+std::atomic<uint64_t>               g_sai_epoch (1);
+thread_local sai_epoch_reader_reg_t t_sai_epoch_reader;
+
+sai_epoch_reader_reg_t::~sai_epoch_reader_reg_t ()
+{
+    if (reader != NULL) {
+        reader->epoch.store (0, std::memory_order_relaxed);
+        reader->in_use.store (false, std::memory_order_release);
+    }
+}
+
+sai_epoch_reader_t *sai_epoch_reader_register (void)
+{
+    sai_epoch_reader_reg_t *reg = &t_sai_epoch_reader;
+    uint32_t                idx;
+    bool                    unused;
+
+    if (reg->registered) {
+        return reg->reader;
+    }
+
+    reg->registered = true;
+
+    for (idx = 0; idx < SAI_EPOCH_MAX_READERS; idx++) {
+        unused = false;
+        if (g_sai_epoch_readers [idx].in_use.compare_exchange_strong (unused, true)) {
+            reg->reader = &g_sai_epoch_readers [idx];
+            break;
+        }
+    }
+
+    return reg->reader;
+}
+
+void sai_epoch_retire (sai_epoch_retire_list_t *list, sai_epoch_obj_t *obj, void *mem)
+{
+    obj->epoch = g_sai_epoch.load ();
+    obj->mem   = mem;
+    obj->next  = list->head;
+
+    list->head = obj;
+    list->count++;
+}
+
+void sai_epoch_reclaim (sai_epoch_retire_list_t *list)
+{
+    sai_epoch_obj_t  *obj;
+    sai_epoch_obj_t **prev;
+    uint64_t          min_epoch = UINT64_MAX;
+    uint64_t          epoch;
+    uint32_t          idx;
+
+    g_sai_epoch.fetch_add (1);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    for (idx = 0; idx < SAI_EPOCH_MAX_READERS; idx++) {
+        epoch = g_sai_epoch_readers [idx].epoch.load (std::memory_order_acquire);
+        if ((epoch != 0) && (epoch < min_epoch)) {
+            min_epoch = epoch;
+        }
+    }
+
+    prev = &list->head;
+    while ((obj = *prev) != NULL) {
+        if ((obj->epoch < min_epoch) &&
+            (obj->pins.load (std::memory_order_acquire) == 0)) {
+            *prev = obj->next;
+            list->count--;
+            free (obj->mem);
+        }
+        else {
+            prev = &obj->next;
+        }
+    }
+}
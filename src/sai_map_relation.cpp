@@ -0,0 +1,1333 @@
+/*
+ * Copyright (c) 2017 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sai_map_relation.cpp
+ *
+ * Object relation store, holding the relations between single objects
+ * listed in SAI_MAP_OID_RELATION_TYPES (see sai_map_relation.h).
+ */
+
+#include "std_mutex_lock.h"
+#include "sai_map_relation.h"
+#include "sai_hash_group.h"
+#include "sai_epoch.h"
+#include <atomic>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <sched.h>
+
+/*
+ * Concurrency model
+ * -----------------
+ * Same as the sai_map stripes: writers serialize on the stripe mutex,
+ * readers run against the stripe sequence counter and retry if a writer
+ * interleaved, and tables and lists a reader may still be looking at are
+ * retired and reclaimed with the epoch scheme of sai_epoch.h.
+ *
+ * What differs is the layout. A slot holds the key object alone, with no
+ * map type and no second id, and elements are single object ids, so that
+ * a slot keeps five elements inline in one cache line where a sai_map slot
+ * keeps two, and lists take half the memory.
+ */
+
+/*
+ * Value list storage. As in sai_map_utl.cpp, the capacity is fixed for the
+ * lifetime of a list, and lists of SAI_OID_RELATION_INDEX_MIN_CAPACITY
+ * elements or more carry an open addressing index on the element, whose
+ * buckets hold the position of an element plus one, or 0 when unused.
+ * Indexed lists delete by moving the last element into the hole.
+ */
+struct sai_oid_relation_list_t {
+    sai_epoch_obj_t       hdr;
+    uint32_t              capacity;
+    std::atomic<uint32_t> count;
+
+    /* Number of index buckets minus one, 0 if the list is not indexed */
+    uint32_t              index_mask;
+    uint32_t             *index;
+    sai_object_id_t       data [1];
+};
+
+#define SAI_OID_RELATION_INDEX_MIN_CAPACITY  (32)
+#define SAI_OID_RELATION_LIST_MIN_CAPACITY   (8)
+
+/* Elements a key stores inline before it needs a separate list */
+#define SAI_OID_RELATION_INLINE_COUNT        (5)
+
+struct sai_oid_relation_slot_t {
+    sai_object_id_t                         key;
+    std::atomic<uint32_t>                   inline_count;
+
+    /* Value list, or NULL while the elements are stored inline */
+    std::atomic<sai_oid_relation_list_t *>  list;
+    sai_object_id_t                         inline_data [SAI_OID_RELATION_INLINE_COUNT];
+};
+
+static_assert (sizeof (sai_oid_relation_slot_t) == 64,
+               "Object relation slot must fill exactly one cache line");
+
+/* Read-side view of the elements of a key, wherever they are stored */
+struct sai_oid_relation_view_t {
+    const sai_object_id_t         *data;
+    uint32_t                       count;
+
+    /* NULL for inline elements */
+    const sai_oid_relation_list_t *list;
+};
+
+struct sai_oid_relation_table_t {
+    sai_epoch_obj_t          hdr;
+    uint32_t                 group_count;
+    uint32_t                 capacity;
+
+    /* Free slots left before the table must be rebuilt. Writer only. */
+    uint32_t                 growth_left;
+    int8_t                  *ctrl;
+    sai_oid_relation_slot_t *slots;
+};
+
+#define SAI_OID_RELATION_RECLAIM_THRESHOLD   (64)
+#define SAI_OID_RELATION_READ_SPIN_MAX       (128)
+
+/*
+ * Each relation is striped by key hash, as a sai_map type is. The high
+ * order bits of the hash select the stripe, the low order bits the slot.
+ */
+#define SAI_OID_RELATION_STRIPES             (16)
+#define SAI_OID_RELATION_STRIPE_SHIFT        (60)
+
+struct alignas(64) sai_oid_relation_stripe_t {
+    std::atomic<uint32_t>                    seq;
+    std::atomic<sai_oid_relation_table_t *>  table;
+    std_mutex_type_t                         mutex;
+
+    /* Following fields are only accessed with the mutex held */
+    uint32_t                                 size;
+    sai_epoch_retire_list_t                  retired;
+
+    /* A table was retired. It is large, so reclaim it without waiting. */
+    bool                                     reclaim_now;
+
+    /*
+     * Keys and elements in the stripe, and the most elements a key of the
+     * stripe has held. Updated with the mutex held, read without it by
+     * sai_oid_relation_stats_get().
+     */
+    std::atomic<uint32_t>                    stat_keys;
+    std::atomic<uint64_t>                    stat_values;
+    std::atomic<uint32_t>                    stat_max_values;
+
+    sai_oid_relation_stripe_t () : seq (0), table (NULL), size (0), retired (),
+                                   reclaim_now (false), stat_keys (0),
+                                   stat_values (0), stat_max_values (0) {
+        std_mutex_lock_init_non_recursive (&mutex);
+    }
+};
+
+struct sai_oid_relation_store_t {
+    sai_oid_relation_stripe_t stripes [SAI_OID_RELATION_STRIPES];
+};
+
+/*
+ * Relations indexed by map type. Only the types of
+ * SAI_MAP_OID_RELATION_TYPES are ever used.
+ */
+static sai_oid_relation_store_t g_sai_oid_relations [SAI_MAP_TYPE_MAX];
+
+/*
+ * Reverse index, from an element back to the keys holding it, for the
+ * types below. It is itself a relation, from element to keys, updated by
+ * the writers of the forward relation with its stripe mutex held. A
+ * reverse stripe mutex is always taken after a forward one, never before.
+ */
+#define SAI_OID_RELATION_REVERSE_TYPES \
+    (1ULL << SAI_MAP_TYPE_BRIDGE_TO_BRIDGE_PORT_LIST)
+
+static sai_oid_relation_store_t g_sai_oid_relation_reverse [SAI_MAP_TYPE_MAX];
+
+static inline sai_oid_relation_store_t *sai_oid_relation_reverse_get (sai_map_type_t type)
+{
+    if (((SAI_OID_RELATION_REVERSE_TYPES >> type) & 1) == 0) {
+        return NULL;
+    }
+
+    return &g_sai_oid_relation_reverse [type];
+}
+
+/*
+ * Runtime statistics, per thread as in sai_map_utl.cpp. Lock times are not
+ * sampled for the relations, and are reported as 0.
+ */
+struct sai_oid_relation_type_stats_t {
+    std::atomic<uint64_t> lookup_hit;
+    std::atomic<uint64_t> lookup_miss;
+    std::atomic<uint64_t> lock_count;
+};
+
+struct alignas(64) sai_oid_relation_thread_stats_t {
+    sai_oid_relation_type_stats_t type [SAI_MAP_TYPE_MAX];
+};
+
+static sai_oid_relation_thread_stats_t g_sai_oid_relation_stats [SAI_EPOCH_MAX_READERS + 1];
+
+static inline sai_oid_relation_type_stats_t *sai_oid_relation_stats_local (sai_map_type_t type)
+{
+    return &g_sai_oid_relation_stats [sai_epoch_reader_index ()].type [type];
+}
+
+static inline void sai_oid_relation_stats_add (std::atomic<uint64_t> &counter)
+{
+    counter.fetch_add (1, std::memory_order_relaxed);
+}
+
+/*
+ * Keeps the stripe counters. 'list_count' is the new element count of the
+ * updated key. Stripe mutex must be held.
+ */
+static inline void sai_oid_relation_counters_update (sai_oid_relation_stripe_t *stripe,
+                                                     int32_t key_count, int64_t value_count,
+                                                     uint32_t list_count)
+{
+    stripe->stat_keys.store (stripe->stat_keys.load (std::memory_order_relaxed) + key_count,
+                             std::memory_order_relaxed);
+    stripe->stat_values.store (stripe->stat_values.load (std::memory_order_relaxed) +
+                               value_count, std::memory_order_relaxed);
+
+    if (list_count > stripe->stat_max_values.load (std::memory_order_relaxed)) {
+        stripe->stat_max_values.store (list_count, std::memory_order_relaxed);
+    }
+}
+
+static inline sai_oid_relation_stripe_t *sai_oid_relation_stripe_get (
+                                                        sai_oid_relation_store_t *store,
+                                                        sai_object_id_t key, uint64_t *p_hash)
+{
+    uint64_t hash = sai_hash_mix64 (key);
+
+    *p_hash = hash;
+
+    return &store->stripes [hash >> SAI_OID_RELATION_STRIPE_SHIFT];
+}
+
+static inline void sai_oid_relation_stripe_lock (sai_oid_relation_stripe_t *stripe,
+                                                 sai_map_type_t type)
+{
+    sai_oid_relation_stats_add (sai_oid_relation_stats_local (type)->lock_count);
+    std_mutex_lock (&stripe->mutex);
+}
+
+static inline void sai_oid_relation_stripe_unlock (sai_oid_relation_stripe_t *stripe)
+{
+    std_mutex_unlock (&stripe->mutex);
+}
+
+static inline uint32_t sai_oid_relation_read_seq_begin (const sai_oid_relation_stripe_t *stripe)
+{
+    uint32_t seq;
+    uint32_t spin = 0;
+
+    while ((seq = stripe->seq.load (std::memory_order_acquire)) & 1) {
+        /* Let a writer that got preempted mid-update run */
+        if (++spin >= SAI_OID_RELATION_READ_SPIN_MAX) {
+            sched_yield ();
+            spin = 0;
+        }
+    }
+
+    return seq;
+}
+
+static inline bool sai_oid_relation_read_seq_retry (const sai_oid_relation_stripe_t *stripe,
+                                                    uint32_t seq)
+{
+    std::atomic_thread_fence (std::memory_order_acquire);
+
+    return (stripe->seq.load (std::memory_order_relaxed) != seq);
+}
+
+static inline void sai_oid_relation_write_begin (sai_oid_relation_stripe_t *stripe)
+{
+    stripe->seq.store (stripe->seq.load (std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+}
+
+static inline void sai_oid_relation_write_end (sai_oid_relation_stripe_t *stripe)
+{
+    stripe->seq.store (stripe->seq.load (std::memory_order_relaxed) + 1,
+                       std::memory_order_release);
+
+    if ((stripe->retired.count >= SAI_OID_RELATION_RECLAIM_THRESHOLD) || stripe->reclaim_now) {
+        stripe->reclaim_now = false;
+        sai_epoch_reclaim (&stripe->retired);
+    }
+}
+
+/*
+ * Must be called with the stripe mutex held, after the object is unlinked.
+ * Tables and lists start with their reclamation header.
+ */
+static void sai_oid_relation_retire (sai_oid_relation_stripe_t *stripe, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    sai_epoch_retire (&stripe->retired, (sai_epoch_obj_t *) ptr, ptr);
+}
+
+static sai_oid_relation_slot_t *sai_oid_relation_slot_find (const sai_oid_relation_table_t *table,
+                                                            sai_object_id_t key, uint64_t hash)
+{
+    const int8_t *group;
+    uint32_t      group_idx;
+    uint32_t      probe;
+    uint32_t      match;
+    uint32_t      slot_idx;
+
+    if (table == NULL) {
+        return NULL;
+    }
+
+    SAI_HASH_FOR_EACH_PROBE_GROUP (table->group_count, hash, group_idx, probe) {
+        group = &table->ctrl [group_idx * SAI_HASH_GROUP_SIZE];
+
+        for (match = sai_hash_group_match (group, sai_hash_h2 (hash));
+             match != 0; match &= (match - 1)) {
+            slot_idx = (group_idx * SAI_HASH_GROUP_SIZE) + __builtin_ctz (match);
+            if (table->slots [slot_idx].key == key) {
+                return &table->slots [slot_idx];
+            }
+        }
+
+        if (sai_hash_group_match (group, SAI_HASH_CTRL_EMPTY) != 0) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/* Writer only. Returns the first free slot in the probe sequence of 'hash'. */
+static uint32_t sai_oid_relation_slot_find_free (const sai_oid_relation_table_t *table,
+                                                 uint64_t hash)
+{
+    uint32_t group_idx;
+    uint32_t probe;
+    uint32_t match;
+
+    SAI_HASH_FOR_EACH_PROBE_GROUP (table->group_count, hash, group_idx, probe) {
+        match = sai_hash_group_match_free (&table->ctrl [group_idx * SAI_HASH_GROUP_SIZE]);
+        if (match != 0) {
+            return (group_idx * SAI_HASH_GROUP_SIZE) + __builtin_ctz (match);
+        }
+    }
+
+    /* Unreachable, growth_left keeps at least one free slot per table */
+    return table->capacity;
+}
+
+static inline void sai_oid_relation_slot_view (const sai_oid_relation_slot_t *slot,
+                                               sai_oid_relation_view_t *view)
+{
+    const sai_oid_relation_list_t *list = slot->list.load (std::memory_order_acquire);
+    uint32_t                       count;
+
+    view->list = list;
+
+    if (list != NULL) {
+        count       = list->count.load (std::memory_order_acquire);
+        view->data  = list->data;
+        view->count = (count > list->capacity) ? list->capacity : count;
+    }
+    else {
+        count       = slot->inline_count.load (std::memory_order_acquire);
+        view->data  = slot->inline_data;
+        view->count = (count > SAI_OID_RELATION_INLINE_COUNT) ?
+                                                SAI_OID_RELATION_INLINE_COUNT : count;
+    }
+}
+
+/*
+ * Runs 'read_fn' on the elements of 'key' in 'store' (NULL if absent)
+ * without taking the stripe mutex. As with sai_map_read(), 'read_fn' may be
+ * invoked more than once, so it must only produce output that the next
+ * invocation fully overwrites.
+ */
+template <typename F>
+static sai_status_t sai_oid_relation_read (sai_map_type_t type, sai_oid_relation_store_t *store,
+                                           sai_object_id_t key, F read_fn)
+{
+    sai_oid_relation_type_stats_t *stats;
+    sai_oid_relation_stripe_t     *stripe;
+    sai_oid_relation_slot_t       *slot;
+    sai_oid_relation_view_t        view;
+    sai_status_t                   rc;
+    uint64_t                       hash;
+    uint32_t                       seq;
+
+    stripe = sai_oid_relation_stripe_get (store, key, &hash);
+
+    if (!sai_epoch_read_lock ()) {
+        sai_oid_relation_stripe_lock (stripe, type);
+        slot = sai_oid_relation_slot_find (stripe->table.load (std::memory_order_relaxed),
+                                           key, hash);
+        if (slot != NULL) {
+            sai_oid_relation_slot_view (slot, &view);
+        }
+        rc   = read_fn ((slot == NULL) ? NULL : &view);
+        sai_oid_relation_stripe_unlock (stripe);
+    }
+    else {
+        do {
+            seq  = sai_oid_relation_read_seq_begin (stripe);
+            slot = sai_oid_relation_slot_find (stripe->table.load (std::memory_order_acquire),
+                                               key, hash);
+            if (slot != NULL) {
+                sai_oid_relation_slot_view (slot, &view);
+            }
+            rc   = read_fn ((slot == NULL) ? NULL : &view);
+        } while (sai_oid_relation_read_seq_retry (stripe, seq));
+
+        sai_epoch_read_unlock ();
+    }
+
+    stats = sai_oid_relation_stats_local (type);
+    sai_oid_relation_stats_add ((slot != NULL) ? stats->lookup_hit : stats->lookup_miss);
+
+    return rc;
+}
+
+static sai_oid_relation_list_t *sai_oid_relation_list_alloc (uint32_t capacity)
+{
+    sai_oid_relation_list_t *list;
+    size_t                   data_size;
+    uint32_t                 index_size = 0;
+
+    if (capacity < SAI_OID_RELATION_LIST_MIN_CAPACITY) {
+        capacity = SAI_OID_RELATION_LIST_MIN_CAPACITY;
+    }
+
+    /* Keep the index at most half full */
+    if (capacity >= SAI_OID_RELATION_INDEX_MIN_CAPACITY) {
+        for (index_size = 1; index_size < (2 * capacity); index_size <<= 1);
+    }
+
+    data_size = sizeof (sai_oid_relation_list_t) + ((capacity - 1) * sizeof (sai_object_id_t));
+
+    list = (sai_oid_relation_list_t *) calloc (1, data_size + (index_size * sizeof (uint32_t)));
+    if (list != NULL) {
+        list->capacity = capacity;
+
+        if (index_size != 0) {
+            list->index_mask = index_size - 1;
+            list->index      = (uint32_t *) ((uint8_t *) list + data_size);
+        }
+    }
+
+    return list;
+}
+
+static inline uint32_t sai_oid_relation_index_bucket (const sai_oid_relation_list_t *list,
+                                                      sai_object_id_t val)
+{
+    return (uint32_t) sai_hash_mix64 (val) & list->index_mask;
+}
+
+/* Writer only. Adds positions [from, to) of the list to its index. */
+static void sai_oid_relation_index_add (sai_oid_relation_list_t *list, uint32_t from, uint32_t to)
+{
+    uint32_t bucket;
+    uint32_t pos;
+
+    if (list->index_mask == 0) {
+        return;
+    }
+
+    for (pos = from; pos < to; pos++) {
+        bucket = sai_oid_relation_index_bucket (list, list->data [pos]);
+        while (list->index [bucket] != 0) {
+            bucket = (bucket + 1) & list->index_mask;
+        }
+        list->index [bucket] = pos + 1;
+    }
+}
+
+/* Writer only. Returns the bucket holding position 'pos'. */
+static uint32_t sai_oid_relation_index_bucket_of (const sai_oid_relation_list_t *list,
+                                                  uint32_t pos)
+{
+    uint32_t bucket = sai_oid_relation_index_bucket (list, list->data [pos]);
+
+    while (list->index [bucket] != (pos + 1)) {
+        bucket = (bucket + 1) & list->index_mask;
+    }
+
+    return bucket;
+}
+
+/*
+ * Writer only. Removes the element at 'pos' from an indexed list of
+ * 'count' elements, moving the last element into its place.
+ */
+static void sai_oid_relation_index_remove (sai_oid_relation_list_t *list, uint32_t pos,
+                                           uint32_t count)
+{
+    uint32_t hole = sai_oid_relation_index_bucket_of (list, pos);
+    uint32_t bucket = hole;
+    uint32_t home;
+    uint32_t last = count - 1;
+
+    /* Backward shift deletion, so that probe sequences need no markers */
+    for (;;) {
+        bucket = (bucket + 1) & list->index_mask;
+        if (list->index [bucket] == 0) {
+            break;
+        }
+
+        home = sai_oid_relation_index_bucket (list, list->data [list->index [bucket] - 1]);
+        if (((bucket - home) & list->index_mask) >= ((bucket - hole) & list->index_mask)) {
+            list->index [hole] = list->index [bucket];
+            hole = bucket;
+        }
+    }
+    list->index [hole] = 0;
+
+    if (pos != last) {
+        list->index [sai_oid_relation_index_bucket_of (list, last)] = pos + 1;
+        list->data [pos] = list->data [last];
+    }
+}
+
+/*
+ * Returns the lowest position of 'val' in 'view', or the view count if it
+ * is absent. The walk is bounded, so that a reader racing a writer
+ * terminates and then fails validation.
+ */
+static uint32_t sai_oid_relation_view_find (const sai_oid_relation_view_t *view,
+                                            sai_object_id_t val)
+{
+    const sai_oid_relation_list_t *list = view->list;
+    uint32_t count = view->count;
+    uint32_t found = count;
+    uint32_t bucket;
+    uint32_t probe;
+    uint32_t pos;
+
+    if ((list == NULL) || (list->index_mask == 0)) {
+        for (pos = 0; pos < count; pos++) {
+            if (view->data [pos] == val) {
+                return pos;
+            }
+        }
+        return count;
+    }
+
+    bucket = sai_oid_relation_index_bucket (list, val);
+
+    for (probe = 0; probe <= list->index_mask; probe++) {
+        pos = list->index [bucket];
+        if (pos == 0) {
+            break;
+        }
+        pos--;
+
+        if ((pos < found) && (list->data [pos] == val)) {
+            found = pos;
+        }
+        bucket = (bucket + 1) & list->index_mask;
+    }
+
+    return found;
+}
+
+/* Number of keys a table of 'group_count' groups takes before a rebuild */
+static inline uint32_t sai_oid_relation_table_max_size (uint32_t group_count)
+{
+    uint32_t capacity = group_count * SAI_HASH_GROUP_SIZE;
+
+    return capacity - (capacity / 8);
+}
+
+static sai_oid_relation_table_t *sai_oid_relation_table_alloc (uint32_t group_count)
+{
+    sai_oid_relation_table_t *table;
+    uint32_t                  capacity = group_count * SAI_HASH_GROUP_SIZE;
+
+    table = (sai_oid_relation_table_t *) calloc (1, sizeof (sai_oid_relation_table_t) + capacity +
+                                                 (capacity * sizeof (sai_oid_relation_slot_t)));
+    if (table == NULL) {
+        return NULL;
+    }
+
+    table->group_count = group_count;
+    table->capacity    = capacity;
+    table->growth_left = sai_oid_relation_table_max_size (group_count);
+    table->slots       = (sai_oid_relation_slot_t *) (table + 1);
+    table->ctrl        = (int8_t *) (table->slots + capacity);
+
+    memset (table->ctrl, SAI_HASH_CTRL_EMPTY, capacity);
+
+    return table;
+}
+
+/* Writer only. Copies the key in 'slot' into 'table'. */
+static void sai_oid_relation_slot_move (sai_oid_relation_table_t *table,
+                                        const sai_oid_relation_slot_t *slot)
+{
+    sai_oid_relation_slot_t *new_slot;
+    uint32_t                 free_idx;
+    uint64_t                 hash = sai_hash_mix64 (slot->key);
+
+    free_idx = sai_oid_relation_slot_find_free (table, hash);
+    new_slot = &table->slots [free_idx];
+
+    new_slot->key = slot->key;
+    new_slot->list.store (slot->list.load (std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+    new_slot->inline_count.store (slot->inline_count.load (std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+    memcpy (new_slot->inline_data, slot->inline_data, sizeof (slot->inline_data));
+
+    if (table->ctrl [free_idx] == SAI_HASH_CTRL_EMPTY) {
+        table->growth_left--;
+    }
+    table->ctrl [free_idx] = sai_hash_h2 (hash);
+}
+
+/*
+ * Writer only, within a write section. Makes room for 'count' more keys.
+ * When the table runs out of free slots it is rebuilt whole, doubled if
+ * the stripe is more than half full, or at the same size to drop deleted
+ * markers otherwise. Unlike the sai_map stripes, keys are not migrated a
+ * few at a time: the relations stored here hold one key per bridge, bridge
+ * port, LAG or tunnel, and the large ones are sized at init through
+ * sai_map_reserve(). Readers still on the old table retry, since the
+ * rebuild happens within the write section.
+ */
+static sai_status_t sai_oid_relation_table_reserve (sai_oid_relation_stripe_t *stripe,
+                                                    uint32_t count)
+{
+    sai_oid_relation_table_t *old_table = stripe->table.load (std::memory_order_relaxed);
+    sai_oid_relation_table_t *new_table;
+    uint32_t                  group_count = 1;
+    uint32_t                  idx;
+
+    if (old_table != NULL) {
+        if (old_table->growth_left >= count) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        group_count = old_table->group_count;
+        if ((stripe->size + count) > (old_table->capacity / 2)) {
+            group_count *= 2;
+        }
+    }
+
+    while ((stripe->size + count) > sai_oid_relation_table_max_size (group_count)) {
+        group_count *= 2;
+    }
+
+    new_table = sai_oid_relation_table_alloc (group_count);
+    if (new_table == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    if (old_table != NULL) {
+        for (idx = 0; idx < old_table->capacity; idx++) {
+            if (old_table->ctrl [idx] >= 0) {
+                sai_oid_relation_slot_move (new_table, &old_table->slots [idx]);
+            }
+        }
+    }
+
+    stripe->table.store (new_table, std::memory_order_release);
+
+    if (old_table != NULL) {
+        /* Lists moved to the new table along with their keys */
+        sai_oid_relation_retire (stripe, old_table);
+        stripe->reclaim_now = true;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Writer only, within a write section. Appends 'val' to the list of 'key'. */
+static sai_status_t sai_oid_relation_append_locked (sai_oid_relation_stripe_t *stripe,
+                                                    sai_object_id_t key, uint64_t hash,
+                                                    sai_object_id_t val)
+{
+    sai_oid_relation_table_t *table;
+    sai_oid_relation_slot_t  *slot;
+    sai_oid_relation_list_t  *list;
+    sai_oid_relation_list_t  *new_list;
+    sai_object_id_t          *elems;
+    sai_status_t              rc;
+    uint32_t                  count;
+    uint32_t                  capacity;
+    uint32_t                  slot_idx;
+
+    slot = sai_oid_relation_slot_find (stripe->table.load (std::memory_order_relaxed), key, hash);
+
+    if (slot != NULL) {
+        list = slot->list.load (std::memory_order_relaxed);
+
+        if (list != NULL) {
+            elems    = list->data;
+            count    = list->count.load (std::memory_order_relaxed);
+            capacity = list->capacity;
+        }
+        else {
+            elems    = slot->inline_data;
+            count    = slot->inline_count.load (std::memory_order_relaxed);
+            capacity = SAI_OID_RELATION_INLINE_COUNT;
+        }
+
+        if (count < capacity) {
+            elems [count] = val;
+
+            if (list != NULL) {
+                sai_oid_relation_index_add (list, count, count + 1);
+                list->count.store (count + 1, std::memory_order_release);
+            }
+            else {
+                slot->inline_count.store (count + 1, std::memory_order_release);
+            }
+        }
+        else {
+            new_list = sai_oid_relation_list_alloc (2 * capacity);
+            if (new_list == NULL) {
+                return SAI_STATUS_NO_MEMORY;
+            }
+
+            memcpy (new_list->data, elems, count * sizeof (sai_object_id_t));
+            new_list->data [count] = val;
+            sai_oid_relation_index_add (new_list, 0, count + 1);
+            new_list->count.store (count + 1, std::memory_order_relaxed);
+
+            slot->list.store (new_list, std::memory_order_release);
+            sai_oid_relation_retire (stripe, list);
+        }
+
+        sai_oid_relation_counters_update (stripe, 0, 1, count + 1);
+        return SAI_STATUS_SUCCESS;
+    }
+
+    rc = sai_oid_relation_table_reserve (stripe, 1);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    table    = stripe->table.load (std::memory_order_relaxed);
+    slot_idx = sai_oid_relation_slot_find_free (table, hash);
+    slot     = &table->slots [slot_idx];
+
+    if (table->ctrl [slot_idx] == SAI_HASH_CTRL_EMPTY) {
+        table->growth_left--;
+    }
+
+    slot->key             = key;
+    slot->inline_data [0] = val;
+    slot->list.store (NULL, std::memory_order_relaxed);
+    slot->inline_count.store (1, std::memory_order_release);
+    table->ctrl [slot_idx] = sai_hash_h2 (hash);
+    stripe->size++;
+    sai_oid_relation_counters_update (stripe, 1, 1, 1);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Writer only, within a write section. Drops the key in 'slot'. */
+static void sai_oid_relation_slot_delete (sai_oid_relation_stripe_t *stripe,
+                                          sai_oid_relation_slot_t *slot)
+{
+    sai_oid_relation_table_t *table = stripe->table.load (std::memory_order_relaxed);
+    sai_oid_relation_view_t   view;
+    uint32_t                  slot_idx = slot - table->slots;
+    int8_t                   *group;
+
+    group = &table->ctrl [slot_idx - (slot_idx % SAI_HASH_GROUP_SIZE)];
+
+    /* As in sai_map_delete_locked(), see there */
+    if (sai_hash_group_match (group, SAI_HASH_CTRL_EMPTY) != 0) {
+        table->ctrl [slot_idx] = SAI_HASH_CTRL_EMPTY;
+        table->growth_left++;
+    }
+    else {
+        table->ctrl [slot_idx] = SAI_HASH_CTRL_DELETED;
+    }
+
+    sai_oid_relation_slot_view (slot, &view);
+
+    sai_oid_relation_retire (stripe, slot->list.load (std::memory_order_relaxed));
+    slot->list.store (NULL, std::memory_order_release);
+    slot->inline_count.store (0, std::memory_order_release);
+    stripe->size--;
+    sai_oid_relation_counters_update (stripe, -1, -((int64_t) view.count), 0);
+}
+
+/*
+ * Writer only, within a write section. Removes the first 'val' of 'key',
+ * and 'key' along with its last element. Returns false if 'val' is absent.
+ */
+static bool sai_oid_relation_remove_locked (sai_oid_relation_stripe_t *stripe,
+                                            sai_object_id_t key, uint64_t hash,
+                                            sai_object_id_t val)
+{
+    sai_oid_relation_slot_t *slot;
+    sai_oid_relation_list_t *list;
+    sai_object_id_t         *elems;
+    sai_oid_relation_view_t  view;
+    uint32_t                 position;
+
+    slot = sai_oid_relation_slot_find (stripe->table.load (std::memory_order_relaxed), key, hash);
+    if (slot == NULL) {
+        return false;
+    }
+
+    sai_oid_relation_slot_view (slot, &view);
+
+    position = sai_oid_relation_view_find (&view, val);
+    if (position >= view.count) {
+        return false;
+    }
+
+    if (view.count == 1) {
+        sai_oid_relation_slot_delete (stripe, slot);
+        return true;
+    }
+
+    list  = slot->list.load (std::memory_order_relaxed);
+    elems = (list != NULL) ? list->data : slot->inline_data;
+
+    if ((list != NULL) && (list->index_mask != 0)) {
+        sai_oid_relation_index_remove (list, position, view.count);
+    }
+    else {
+        memmove (&elems [position], &elems [position + 1],
+                 (view.count - position - 1) * sizeof (sai_object_id_t));
+    }
+
+    if (list != NULL) {
+        list->count.store (view.count - 1, std::memory_order_release);
+    }
+    else {
+        slot->inline_count.store (view.count - 1, std::memory_order_release);
+    }
+    sai_oid_relation_counters_update (stripe, 0, -1, 0);
+
+    return true;
+}
+
+/* Appends 'val' to 'key' in 'store', taking the stripe mutex */
+static sai_status_t sai_oid_relation_store_append (sai_map_type_t type,
+                                                   sai_oid_relation_store_t *store,
+                                                   sai_object_id_t key, sai_object_id_t val)
+{
+    sai_oid_relation_stripe_t *stripe;
+    sai_status_t               rc;
+    uint64_t                   hash;
+
+    stripe = sai_oid_relation_stripe_get (store, key, &hash);
+
+    sai_oid_relation_stripe_lock (stripe, type);
+    sai_oid_relation_write_begin (stripe);
+
+    rc = sai_oid_relation_append_locked (stripe, key, hash, val);
+
+    sai_oid_relation_write_end (stripe);
+    sai_oid_relation_stripe_unlock (stripe);
+
+    return rc;
+}
+
+/* Removes 'val' from 'key' in 'store', taking the stripe mutex */
+static void sai_oid_relation_store_remove (sai_map_type_t type, sai_oid_relation_store_t *store,
+                                           sai_object_id_t key, sai_object_id_t val)
+{
+    sai_oid_relation_stripe_t *stripe;
+    uint64_t                   hash;
+
+    stripe = sai_oid_relation_stripe_get (store, key, &hash);
+
+    sai_oid_relation_stripe_lock (stripe, type);
+    sai_oid_relation_write_begin (stripe);
+
+    sai_oid_relation_remove_locked (stripe, key, hash, val);
+
+    sai_oid_relation_write_end (stripe);
+    sai_oid_relation_stripe_unlock (stripe);
+}
+
+/*
+ * Writer of the forward relation, within a write section. Appends 'val' to
+ * 'key', and 'key' to the reverse list of 'val' for reverse indexed types.
+ */
+static sai_status_t sai_oid_relation_insert_locked (sai_map_type_t type,
+                                                    sai_oid_relation_stripe_t *stripe,
+                                                    sai_object_id_t key, uint64_t hash,
+                                                    sai_object_id_t val)
+{
+    sai_oid_relation_store_t *reverse = sai_oid_relation_reverse_get (type);
+    sai_status_t              rc;
+
+    if (reverse != NULL) {
+        rc = sai_oid_relation_store_append (type, reverse, val, key);
+        if (rc != SAI_STATUS_SUCCESS) {
+            return rc;
+        }
+    }
+
+    rc = sai_oid_relation_append_locked (stripe, key, hash, val);
+
+    if ((rc != SAI_STATUS_SUCCESS) && (reverse != NULL)) {
+        sai_oid_relation_store_remove (type, reverse, val, key);
+    }
+
+    return rc;
+}
+
+extern "C" {
+
+sai_status_t sai_oid_relation_insert (sai_map_type_t type, sai_object_id_t key,
+                                      sai_object_id_t val)
+{
+    sai_oid_relation_stripe_t *stripe;
+    sai_status_t               rc;
+    uint64_t                   hash;
+
+    if (!sai_map_oid_relation_type (type)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    stripe = sai_oid_relation_stripe_get (&g_sai_oid_relations [type], key, &hash);
+
+    sai_oid_relation_stripe_lock (stripe, type);
+    sai_oid_relation_write_begin (stripe);
+
+    rc = sai_oid_relation_insert_locked (type, stripe, key, hash, val);
+
+    sai_oid_relation_write_end (stripe);
+    sai_oid_relation_stripe_unlock (stripe);
+
+    return rc;
+}
+
+sai_status_t sai_oid_relation_remove (sai_map_type_t type, sai_object_id_t key,
+                                      sai_object_id_t val)
+{
+    sai_oid_relation_store_t  *reverse;
+    sai_oid_relation_stripe_t *stripe;
+    uint64_t                   hash;
+
+    if (!sai_map_oid_relation_type (type)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    stripe  = sai_oid_relation_stripe_get (&g_sai_oid_relations [type], key, &hash);
+    reverse = sai_oid_relation_reverse_get (type);
+
+    sai_oid_relation_stripe_lock (stripe, type);
+    sai_oid_relation_write_begin (stripe);
+
+    if (sai_oid_relation_remove_locked (stripe, key, hash, val) && (reverse != NULL)) {
+        sai_oid_relation_store_remove (type, reverse, val, key);
+    }
+
+    sai_oid_relation_write_end (stripe);
+    sai_oid_relation_stripe_unlock (stripe);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_oid_relation_erase (sai_map_type_t type, sai_object_id_t key)
+{
+    sai_oid_relation_store_t  *reverse;
+    sai_oid_relation_stripe_t *stripe;
+    sai_oid_relation_slot_t   *slot;
+    sai_oid_relation_view_t    view;
+    uint64_t                   hash;
+    uint32_t                   idx;
+
+    if (!sai_map_oid_relation_type (type)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    stripe  = sai_oid_relation_stripe_get (&g_sai_oid_relations [type], key, &hash);
+    reverse = sai_oid_relation_reverse_get (type);
+
+    sai_oid_relation_stripe_lock (stripe, type);
+
+    slot = sai_oid_relation_slot_find (stripe->table.load (std::memory_order_relaxed), key, hash);
+
+    if (slot != NULL) {
+        sai_oid_relation_write_begin (stripe);
+
+        if (reverse != NULL) {
+            sai_oid_relation_slot_view (slot, &view);
+            for (idx = 0; idx < view.count; idx++) {
+                sai_oid_relation_store_remove (type, reverse, view.data [idx], key);
+            }
+        }
+
+        sai_oid_relation_slot_delete (stripe, slot);
+        sai_oid_relation_write_end (stripe);
+    }
+
+    sai_oid_relation_stripe_unlock (stripe);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_oid_relation_bulk_insert (sai_map_type_t         type,
+                                           uint32_t               count,
+                                           const sai_object_id_t *key_list,
+                                           const sai_object_id_t *val_list,
+                                           sai_status_t          *status_list)
+{
+    sai_oid_relation_stripe_t *stripe;
+    uint32_t                   start [SAI_OID_RELATION_STRIPES + 1];
+    uint32_t                  *order;
+    uint64_t                   hash;
+    uint32_t                   failed = 0;
+    uint32_t                   stripe_idx;
+    uint32_t                   idx;
+    uint32_t                   pos;
+
+    if ((!sai_map_oid_relation_type (type)) || (count == 0) || (key_list == NULL) ||
+        (val_list == NULL) || (status_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    order = (uint32_t *) calloc (count, sizeof (uint32_t));
+    if (order == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    /*
+     * Group the entries by stripe with a counting sort, keeping the request
+     * order within a stripe, so that each stripe mutex is taken once.
+     */
+    memset (start, 0, sizeof (start));
+
+    for (idx = 0; idx < count; idx++) {
+        start [(sai_hash_mix64 (key_list [idx]) >> SAI_OID_RELATION_STRIPE_SHIFT) + 1]++;
+    }
+
+    for (stripe_idx = 0; stripe_idx < SAI_OID_RELATION_STRIPES; stripe_idx++) {
+        start [stripe_idx + 1] += start [stripe_idx];
+    }
+
+    for (idx = 0; idx < count; idx++) {
+        stripe_idx = sai_hash_mix64 (key_list [idx]) >> SAI_OID_RELATION_STRIPE_SHIFT;
+        order [start [stripe_idx]++] = idx;
+    }
+
+    /* start [stripe] now holds the end of its run, and the next one's start */
+    pos = 0;
+
+    for (stripe_idx = 0; stripe_idx < SAI_OID_RELATION_STRIPES; stripe_idx++) {
+        if (pos == start [stripe_idx]) {
+            continue;
+        }
+
+        stripe = &g_sai_oid_relations [type].stripes [stripe_idx];
+
+        sai_oid_relation_stripe_lock (stripe, type);
+        sai_oid_relation_write_begin (stripe);
+
+        for (; pos < start [stripe_idx]; pos++) {
+            idx  = order [pos];
+            hash = sai_hash_mix64 (key_list [idx]);
+
+            status_list [idx] = sai_oid_relation_insert_locked (type, stripe, key_list [idx],
+                                                                hash, val_list [idx]);
+            if (status_list [idx] != SAI_STATUS_SUCCESS) {
+                failed++;
+            }
+        }
+
+        sai_oid_relation_write_end (stripe);
+        sai_oid_relation_stripe_unlock (stripe);
+    }
+
+    free (order);
+
+    return (failed == 0) ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE;
+}
+
+sai_status_t sai_oid_relation_reserve (sai_map_type_t type, uint32_t count)
+{
+    sai_oid_relation_stripe_t *stripe;
+    sai_status_t               rc = SAI_STATUS_SUCCESS;
+    uint32_t                   stripe_count;
+    uint32_t                   idx;
+
+    if (!sai_map_oid_relation_type (type)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* Keys spread evenly over the stripes, give each a little headroom */
+    stripe_count = ((count + (count / 8)) / SAI_OID_RELATION_STRIPES) + 1;
+
+    for (idx = 0; (idx < SAI_OID_RELATION_STRIPES) && (rc == SAI_STATUS_SUCCESS); idx++) {
+        stripe = &g_sai_oid_relations [type].stripes [idx];
+
+        sai_oid_relation_stripe_lock (stripe, type);
+
+        if (stripe->size < stripe_count) {
+            sai_oid_relation_write_begin (stripe);
+            rc = sai_oid_relation_table_reserve (stripe, stripe_count - stripe->size);
+            sai_oid_relation_write_end (stripe);
+        }
+
+        sai_oid_relation_stripe_unlock (stripe);
+    }
+
+    return rc;
+}
+
+sai_status_t sai_oid_relation_get (sai_map_type_t type, sai_object_id_t key,
+                                   sai_object_id_t *val)
+{
+    if ((!sai_map_oid_relation_type (type)) || (val == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_oid_relation_read (type, &g_sai_oid_relations [type], key,
+                                  [&] (const sai_oid_relation_view_t *view) -> sai_status_t {
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        if (view->count > 1) {
+            return SAI_STATUS_BUFFER_OVERFLOW;
+        }
+
+        *val = view->data [0];
+
+        return SAI_STATUS_SUCCESS;
+    });
+}
+
+sai_status_t sai_oid_relation_get_at_index (sai_map_type_t type, sai_object_id_t key,
+                                            uint32_t index, sai_object_id_t *val)
+{
+    if ((!sai_map_oid_relation_type (type)) || (val == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_oid_relation_read (type, &g_sai_oid_relations [type], key,
+                                  [&] (const sai_oid_relation_view_t *view) -> sai_status_t {
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        if (index >= view->count) {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        *val = view->data [index];
+
+        return SAI_STATUS_SUCCESS;
+    });
+}
+
+sai_status_t sai_oid_relation_count (sai_map_type_t type, sai_object_id_t key, uint32_t *count)
+{
+    if ((!sai_map_oid_relation_type (type)) || (count == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_oid_relation_read (type, &g_sai_oid_relations [type], key,
+                                  [&] (const sai_oid_relation_view_t *view) -> sai_status_t {
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        *count = view->count;
+
+        return SAI_STATUS_SUCCESS;
+    });
+}
+
+sai_status_t sai_oid_relation_val_list (sai_map_type_t type, sai_object_id_t key,
+                                        uint32_t *count, sai_object_id_t *val_list)
+{
+    sai_status_t rc;
+    uint32_t     list_count = 0;
+
+    if ((!sai_map_oid_relation_type (type)) || (count == NULL) || (val_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    const uint32_t buf_count = *count;
+
+    rc = sai_oid_relation_read (type, &g_sai_oid_relations [type], key,
+                                [&] (const sai_oid_relation_view_t *view) -> sai_status_t {
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        list_count = view->count;
+
+        if (list_count > buf_count) {
+            return SAI_STATUS_BUFFER_OVERFLOW;
+        }
+
+        memcpy (val_list, view->data, list_count * sizeof (sai_object_id_t));
+
+        return SAI_STATUS_SUCCESS;
+    });
+
+    if ((rc == SAI_STATUS_SUCCESS) || (rc == SAI_STATUS_BUFFER_OVERFLOW)) {
+        *count = list_count;
+    }
+
+    return rc;
+}
+
+bool sai_oid_relation_contains (sai_map_type_t type, sai_object_id_t key, sai_object_id_t val)
+{
+    if (!sai_map_oid_relation_type (type)) {
+        return false;
+    }
+
+    return (sai_oid_relation_read (type, &g_sai_oid_relations [type], key,
+                                   [&] (const sai_oid_relation_view_t *view) -> sai_status_t {
+        if ((view == NULL) || (sai_oid_relation_view_find (view, val) >= view->count)) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        return SAI_STATUS_SUCCESS;
+    }) == SAI_STATUS_SUCCESS);
+}
+
+sai_status_t sai_oid_relation_foreach (sai_map_type_t type, sai_object_id_t key,
+                                       sai_map_visit_fn visit_fn, void *ctx)
+{
+    sai_object_id_t  inline_list [SAI_OID_RELATION_INLINE_COUNT];
+    sai_object_id_t *val_list = inline_list;
+    sai_map_data_t   data = {SAI_NULL_OBJECT_ID, SAI_NULL_OBJECT_ID};
+    sai_status_t     rc;
+    uint32_t         count = SAI_OID_RELATION_INLINE_COUNT;
+    uint32_t         idx;
+
+    if (visit_fn == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /*
+     * The elements are visited on a copy of the list, so that the callback
+     * may use any other relation API, including on the same key.
+     */
+    while ((rc = sai_oid_relation_val_list (type, key, &count, val_list)) ==
+                                                            SAI_STATUS_BUFFER_OVERFLOW) {
+        if (val_list != inline_list) {
+            free (val_list);
+        }
+
+        val_list = (sai_object_id_t *) calloc (count, sizeof (sai_object_id_t));
+        if (val_list == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+    }
+
+    if (rc == SAI_STATUS_SUCCESS) {
+        for (idx = 0; idx < count; idx++) {
+            data.val1 = val_list [idx];
+            if (!visit_fn (&data, ctx)) {
+                break;
+            }
+        }
+    }
+
+    if (val_list != inline_list) {
+        free (val_list);
+    }
+
+    return rc;
+}
+
+sai_status_t sai_oid_relation_reverse_get (sai_map_type_t type, sai_object_id_t val,
+                                           sai_object_id_t *key)
+{
+    sai_oid_relation_store_t *reverse;
+
+    if ((!sai_map_oid_relation_type (type)) || (key == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    reverse = sai_oid_relation_reverse_get (type);
+    if (reverse == NULL) {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    return sai_oid_relation_read (type, reverse, val,
+                                  [&] (const sai_oid_relation_view_t *view) -> sai_status_t {
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        if (view->count > 1) {
+            return SAI_STATUS_BUFFER_OVERFLOW;
+        }
+
+        *key = view->data [0];
+
+        return SAI_STATUS_SUCCESS;
+    });
+}
+
+sai_status_t sai_oid_relation_stats_get (sai_map_type_t type, sai_map_stats_t *stats)
+{
+    const sai_oid_relation_type_stats_t *thread_stats;
+    const sai_oid_relation_stripe_t     *stripe;
+    uint32_t                             max_values;
+    uint32_t                             idx;
+
+    if ((!sai_map_oid_relation_type (type)) || (stats == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    memset (stats, 0, sizeof (*stats));
+
+    for (idx = 0; idx <= SAI_EPOCH_MAX_READERS; idx++) {
+        thread_stats = &g_sai_oid_relation_stats [idx].type [type];
+
+        stats->lookup_hit  += thread_stats->lookup_hit.load (std::memory_order_relaxed);
+        stats->lookup_miss += thread_stats->lookup_miss.load (std::memory_order_relaxed);
+        stats->lock_count  += thread_stats->lock_count.load (std::memory_order_relaxed);
+    }
+
+    /* Stripe counters are read without the stripe mutex */
+    for (idx = 0; idx < SAI_OID_RELATION_STRIPES; idx++) {
+        stripe = &g_sai_oid_relations [type].stripes [idx];
+
+        stats->key_count   += stripe->stat_keys.load (std::memory_order_relaxed);
+        stats->value_count += stripe->stat_values.load (std::memory_order_relaxed);
+        max_values          = stripe->stat_max_values.load (std::memory_order_relaxed);
+        if (max_values > stats->max_value_count) {
+            stats->max_value_count = max_values;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+}
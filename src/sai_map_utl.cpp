@@ -20,317 +20,2139 @@
 
 #include "std_mutex_lock.h"
 #include "sai_map_utl.h"
+#include "sai_map_relation.h"
+#include "sai_debug_utils.h"
+#include "sai_hash_group.h"
+#include "sai_epoch.h"
+extern "C" {
+#include "sai_shell.h"
+}
+#include <atomic>
 #include <unordered_map>
 #include <vector>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <sched.h>
+#include <time.h>
+#include <inttypes.h>
 
 struct _sai_map_hash
 {
-    uint32_t operator()(const sai_map_key_t& key) const {
-        uint32_t hash;
+    /*
+     * The fields are mixed in sequence rather than XORed together, so
+     * that {id1, id2} and {id2, id1} hash differently.
+     */
+    uint64_t operator()(const sai_map_key_t& key) const {
+        uint64_t hash;
 
-        hash  = std::hash<int>()(key.type);
-        hash ^= std::hash<uint64_t>()(key.id1);
-        hash ^= std::hash<uint64_t>()(key.id2);
+        hash = (uint64_t) key.type * 0x9e3779b97f4a7c15ULL;
+        hash = sai_hash_mix64 (hash ^ key.id1);
+        hash = sai_hash_mix64 (hash ^ key.id2);
         return (hash);
     }
 };
 
-struct _sai_map_equal
+/*
+ * Concurrency model
+ * -----------------
+ * Writers serialize on the stripe mutex. Readers never take it: they run
+ * optimistically against a per-stripe sequence counter (odd while a writer
+ * is updating the stripe) and retry if a writer interleaved. Memory that a
+ * reader may still be looking at (nodes, value lists, bucket arrays) is not
+ * freed by the writer directly, but retired and reclaimed once every reader
+ * that could hold a reference to it has left its read-side section, with
+ * the epoch scheme of sai_epoch.h. Value lists are pinned while an open
+ * cursor holds a snapshot of them.
+ */
+
+/*
+ * Value list storage. The capacity is fixed for the lifetime of a list,
+ * so a reader can always bound its accesses even when it races a writer.
+ *
+ * Lists of SAI_MAP_INDEX_MIN_CAPACITY elements or more also carry an open
+ * addressing index on val1, allocated along with the list. Each bucket
+ * holds the position of an element plus one, or 0 when unused. Indexed
+ * lists delete by moving the last element into the hole, so their element
+ * order is not preserved.
+ */
+struct sai_map_list_t {
+    sai_epoch_obj_t       hdr;
+    uint32_t              capacity;
+    std::atomic<uint32_t> count;
+
+    /* Number of index buckets minus one, 0 if the list is not indexed */
+    uint32_t              index_mask;
+    uint32_t             *index;
+    sai_map_data_t        data [1];
+};
+
+#define SAI_MAP_INDEX_MIN_CAPACITY    (32)
+
+/*
+ * Each stripe is an open addressing table, probed in control byte groups
+ * with the primitives of sai_hash_group.h.
+ */
+
+/*
+ * Up to SAI_MAP_INLINE_COUNT values are kept in the slot itself, which
+ * covers the single element map types without a list allocation per key.
+ * A key moves to a separate list once it outgrows the inline storage, and
+ * keeps it until the key is deleted. The key fields are stored unpacked so
+ * that the inline count fills the padding after the type, and a slot with
+ * two inline values takes exactly one cache line.
+ */
+struct sai_map_slot_t {
+    uint32_t                       type;
+    std::atomic<uint32_t>          inline_count;
+    sai_object_id_t                id1;
+    sai_object_id_t                id2;
+
+    /* Value list, or NULL while the values are stored inline */
+    std::atomic<sai_map_list_t *>  list;
+    sai_map_data_t                 inline_data [SAI_MAP_INLINE_COUNT];
+};
+
+static inline bool sai_map_slot_key_equal (const sai_map_slot_t *slot, const sai_map_key_t *key)
 {
-    bool operator()(const sai_map_key_t& key1, const sai_map_key_t& key2) const {
-        if ((key1.type == key2.type) &&
-            (key1.id1 == key2.id1) && (key1.id2 == key2.id2)) {
-            return true;
-        }
-        else {
-            return false;
-        }
+    return ((slot->id1 == key->id1) && (slot->id2 == key->id2) &&
+            (slot->type == (uint32_t) key->type));
+}
+
+static inline void sai_map_slot_key_get (const sai_map_slot_t *slot, sai_map_key_t *key)
+{
+    memset (key, 0, sizeof (*key));
+
+    key->type = (sai_map_type_t) slot->type;
+    key->id1  = slot->id1;
+    key->id2  = slot->id2;
+}
+
+/* Read-side view of the values of a key, wherever they are stored */
+struct sai_map_view_t {
+    const sai_map_data_t *data;
+    uint32_t              count;
+
+    /* NULL for inline values */
+    const sai_map_list_t *list;
+};
+
+struct sai_map_table_t {
+    sai_epoch_obj_t       hdr;
+    uint32_t              group_count;
+    uint32_t              capacity;
+
+    /* Free slots left before the table must be rebuilt. Writer only. */
+    uint32_t              growth_left;
+    int8_t               *ctrl;
+    sai_map_slot_t       *slots;
+};
+
+#define SAI_MAP_LIST_MIN_CAPACITY     (4)
+#define SAI_MAP_RECLAIM_THRESHOLD     (64)
+#define SAI_MAP_READ_SPIN_MAX         (128)
+
+/* Slots of the old table moved into the new one on each update */
+#define SAI_MAP_MIGRATE_SLOTS         (4 * SAI_HASH_GROUP_SIZE)
+
+/*
+ * The map is partitioned by sai_map_type_t, and each type is further
+ * striped by key hash. Every stripe has its own lock and table, so that
+ * lookups on unrelated relationships (e.g. bridge ports and NH group
+ * members) never serialize on a common lock.
+ */
+#define SAI_MAP_STRIPES_PER_TYPE  (16)
+#define SAI_MAP_STRIPE_SHIFT      (60)
+
+struct alignas(64) sai_map_shard_t {
+    std::atomic<uint32_t>           seq;
+    std::atomic<sai_map_table_t *>  table;
+
+    /* Table whose keys are still being moved into 'table', or NULL */
+    std::atomic<sai_map_table_t *>  old_table;
+    std_mutex_type_t                mutex;
+
+    /* Following fields are only accessed with the mutex held */
+    uint32_t                        size;
+
+    /* Next slot of 'old_table' to move, and keys it still holds */
+    uint32_t                        migrate_pos;
+    uint32_t                        migrate_left;
+    sai_epoch_retire_list_t         retired;
+
+    /* A table was retired. It is large, so reclaim it without waiting. */
+    bool                            reclaim_now;
+
+    /* When the current holder took the mutex, for the statistics */
+    uint64_t                        lock_time;
+
+    /*
+     * Keys and elements in the stripe, and the most elements a key of the
+     * stripe has held. Updated with the mutex held, read without it by
+     * sai_map_stats_get().
+     */
+    std::atomic<uint32_t>           stat_keys;
+    std::atomic<uint64_t>           stat_values;
+    std::atomic<uint32_t>           stat_max_values;
+
+    sai_map_shard_t () : seq (0), table (NULL), old_table (NULL), size (0),
+                         migrate_pos (0), migrate_left (0), retired (),
+                         reclaim_now (false), lock_time (0),
+                         stat_keys (0), stat_values (0), stat_max_values (0) {
+        std_mutex_lock_init_non_recursive (&mutex);
     }
 };
 
-static inline bool operator==(const sai_map_key_t& key1, const sai_map_key_t& key2)
+static sai_map_shard_t g_sai_map_shards [SAI_MAP_TYPE_MAX][SAI_MAP_STRIPES_PER_TYPE];
+
+#define SAI_MAP_STRIPE_COUNT  (SAI_MAP_TYPE_MAX * SAI_MAP_STRIPES_PER_TYPE)
+
+static inline uint32_t sai_map_stripe_index (const sai_map_shard_t *shard)
 {
-    return _sai_map_equal()(key1, key2);
+    return (uint32_t) (shard - &g_sai_map_shards [0][0]);
 }
 
-std_mutex_lock_create_static_init_fast (sai_map_mutex);
+/*
+ * Runtime statistics. Each thread updates the block matching its reader
+ * slot, so counters are never shared between running threads, and the
+ * blocks are only summed when read. Threads without a reader slot share
+ * the last block. Reading the clock costs about as much as an update, so
+ * lock times are only measured on one acquisition in
+ * SAI_MAP_STATS_LOCK_SAMPLE and scaled up when read.
+ */
+#define SAI_MAP_STATS_LOCK_SAMPLE  (16)
+
+struct sai_map_type_stats_t {
+    std::atomic<uint64_t> lookup_hit;
+    std::atomic<uint64_t> lookup_miss;
+    std::atomic<uint64_t> lock_count;
+    std::atomic<uint64_t> lock_sampled;
+    std::atomic<uint64_t> lock_wait_ns;
+    std::atomic<uint64_t> lock_hold_ns;
+};
 
-static std::unordered_map<sai_map_key_t, std::vector <sai_map_data_t>, _sai_map_hash, _sai_map_equal> g_sai_map;
+static thread_local uint32_t t_sai_map_lock_seq;
 
-static bool sai_map_apply_filter (sai_map_data_t       *arg1,
-                                      sai_map_data_t       *arg2,
-                                      sai_map_val_filter_t  filter)
+struct alignas(64) sai_map_thread_stats_t {
+    sai_map_type_stats_t type [SAI_MAP_TYPE_MAX];
+};
+
+static sai_map_thread_stats_t g_sai_map_stats [SAI_EPOCH_MAX_READERS + 1];
+
+static inline sai_map_type_stats_t *sai_map_stats_local (uint32_t type)
 {
-    if ((filter & SAI_MAP_VAL_FILTER_NONE) == SAI_MAP_VAL_FILTER_NONE) {
-        return true;
+    return &g_sai_map_stats [sai_epoch_reader_index ()].type [type];
+}
+
+static inline void sai_map_stats_add (std::atomic<uint64_t> &counter, uint64_t value)
+{
+    counter.fetch_add (value, std::memory_order_relaxed);
+}
+
+static inline uint64_t sai_map_time_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime (CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t) ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+static inline void sai_map_stats_lookup (uint32_t type, bool hit)
+{
+    sai_map_type_stats_t *stats = sai_map_stats_local (type);
+
+    sai_map_stats_add (hit ? stats->lookup_hit : stats->lookup_miss, 1);
+}
+
+/* Takes the stripe mutex, accounting the time spent waiting for it */
+static inline void sai_map_stripe_lock (sai_map_shard_t *shard)
+{
+    sai_map_type_stats_t *stats;
+    uint64_t              start;
+
+    stats = sai_map_stats_local (sai_map_stripe_index (shard) / SAI_MAP_STRIPES_PER_TYPE);
+    sai_map_stats_add (stats->lock_count, 1);
+
+    if ((++t_sai_map_lock_seq % SAI_MAP_STATS_LOCK_SAMPLE) != 0) {
+        std_mutex_lock (&shard->mutex);
+        shard->lock_time = 0;
+        return;
     }
 
-    if ((filter & SAI_MAP_VAL_FILTER_VAL1) == SAI_MAP_VAL_FILTER_VAL1) {
-        if (arg1->val1 != arg2->val1) {
-            return false;
-        }
+    start = sai_map_time_ns ();
+    std_mutex_lock (&shard->mutex);
+    shard->lock_time = sai_map_time_ns ();
+
+    sai_map_stats_add (stats->lock_sampled, 1);
+    sai_map_stats_add (stats->lock_wait_ns, shard->lock_time - start);
+}
+
+/* Releases the stripe mutex, accounting the time it was held if sampled */
+static inline void sai_map_stripe_unlock (sai_map_shard_t *shard)
+{
+    uint64_t lock_time = shard->lock_time;
+    uint64_t hold;
+
+    if (lock_time == 0) {
+        std_mutex_unlock (&shard->mutex);
+        return;
     }
 
-    if ((filter & SAI_MAP_VAL_FILTER_VAL2) == SAI_MAP_VAL_FILTER_VAL2) {
-        if (arg1->val2 != arg2->val2) {
-            return false;
+    hold = sai_map_time_ns () - lock_time;
+    std_mutex_unlock (&shard->mutex);
+
+    sai_map_stats_add (sai_map_stats_local (sai_map_stripe_index (shard) /
+                                            SAI_MAP_STRIPES_PER_TYPE)->lock_hold_ns, hold);
+}
+
+/*
+ * Keeps the stripe counters read by sai_map_stats_get(). 'list_count' is
+ * the new element count of the updated key. Stripe mutex must be held.
+ */
+static inline void sai_map_stripe_counters_update (sai_map_shard_t *shard, int32_t key_count,
+                                                   int64_t value_count, uint32_t list_count)
+{
+    shard->stat_keys.store (shard->stat_keys.load (std::memory_order_relaxed) + key_count,
+                            std::memory_order_relaxed);
+    shard->stat_values.store (shard->stat_values.load (std::memory_order_relaxed) + value_count,
+                              std::memory_order_relaxed);
+
+    if (list_count > shard->stat_max_values.load (std::memory_order_relaxed)) {
+        shard->stat_max_values.store (list_count, std::memory_order_relaxed);
+    }
+}
+
+static inline uint32_t sai_map_read_seq_begin (const sai_map_shard_t *shard)
+{
+    uint32_t seq;
+    uint32_t spin = 0;
+
+    while ((seq = shard->seq.load (std::memory_order_acquire)) & 1) {
+        /*
+         * A writer is mid-update. Its critical section is short, so spin,
+         * but let it run if it got preempted while holding the stripe.
+         */
+        if (++spin >= SAI_MAP_READ_SPIN_MAX) {
+            sched_yield ();
+            spin = 0;
         }
     }
 
-    return true;
+    return seq;
 }
 
-static void sai_map_copy_value (sai_map_data_t       *dst,
-                                    sai_map_data_t       *src,
-                                    sai_map_val_filter_t  filter)
+static inline bool sai_map_read_seq_retry (const sai_map_shard_t *shard, uint32_t seq)
 {
-    if ((filter & SAI_MAP_VAL_FILTER_NONE) == SAI_MAP_VAL_FILTER_NONE) {
-        *dst = *src;
-        return;
-    }
+    std::atomic_thread_fence (std::memory_order_acquire);
 
-    if ((filter & SAI_MAP_VAL_FILTER_VAL1) == SAI_MAP_VAL_FILTER_VAL1) {
-        dst->val1 = src->val1;
+    return (shard->seq.load (std::memory_order_relaxed) != seq);
+}
+
+static inline void sai_map_write_begin (sai_map_shard_t *shard)
+{
+    shard->seq.store (shard->seq.load (std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+}
+
+static void sai_map_table_migrate (sai_map_shard_t *shard, uint32_t slot_count);
+
+static inline void sai_map_write_end (sai_map_shard_t *shard)
+{
+    if (shard->old_table.load (std::memory_order_relaxed) != NULL) {
+        sai_map_table_migrate (shard, SAI_MAP_MIGRATE_SLOTS);
     }
 
-    if ((filter & SAI_MAP_VAL_FILTER_VAL2) == SAI_MAP_VAL_FILTER_VAL2) {
-        dst->val2 = src->val2;
+    shard->seq.store (shard->seq.load (std::memory_order_relaxed) + 1,
+                      std::memory_order_release);
+
+    if ((shard->retired.count >= SAI_MAP_RECLAIM_THRESHOLD) || shard->reclaim_now) {
+        shard->reclaim_now = false;
+        sai_epoch_reclaim (&shard->retired);
     }
 }
 
-extern "C" {
+/*
+ * Must be called with the stripe mutex held, after the object is unlinked.
+ * Tables and lists start with their reclamation header.
+ */
+static void sai_map_retire (sai_map_shard_t *shard, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
 
-sai_status_t sai_map_insert (sai_map_key_t *key, sai_map_val_t *value)
+    sai_epoch_retire (&shard->retired, (sai_epoch_obj_t *) ptr, ptr);
+}
+
+static inline sai_map_shard_t *sai_map_shard_get (const sai_map_key_t *key,
+                                                  uint64_t *p_hash)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
-    uint32_t     i;
+    uint64_t hash;
+
+    /* Types of the object relation store are only reached through it */
+    if ((key == NULL) || ((uint32_t) key->type >= SAI_MAP_TYPE_MAX) ||
+        sai_map_oid_relation_type (key->type)) {
+        return NULL;
+    }
 
-    std_mutex_lock (&sai_map_mutex);
+    hash = _sai_map_hash()(*key);
+    *p_hash = hash;
 
-    try {
-        auto map_it = g_sai_map.find (*key);
+    /* High order bits select the stripe, low order bits the slot */
+    return &g_sai_map_shards [key->type][hash >> SAI_MAP_STRIPE_SHIFT];
+}
+
+static sai_map_slot_t *sai_map_slot_find (const sai_map_table_t *table,
+                                          const sai_map_key_t *key, uint64_t hash)
+{
+    const int8_t *group;
+    uint32_t      group_idx;
+    uint32_t      probe;
+    uint32_t      match;
+    uint32_t      slot_idx;
+
+    if (table == NULL) {
+        return NULL;
+    }
 
-        if (map_it != g_sai_map.end()) {
-            std::vector <sai_map_data_t>& list = map_it->second;
+    SAI_HASH_FOR_EACH_PROBE_GROUP (table->group_count, hash, group_idx, probe) {
+        group = &table->ctrl [group_idx * SAI_HASH_GROUP_SIZE];
 
-            for (i = 0; i < value->count; i++) {
-                list.push_back (value->data[i]);
+        for (match = sai_hash_group_match (group, sai_hash_h2 (hash));
+             match != 0; match &= (match - 1)) {
+            slot_idx = (group_idx * SAI_HASH_GROUP_SIZE) + __builtin_ctz (match);
+            if (sai_map_slot_key_equal (&table->slots [slot_idx], key)) {
+                return &table->slots [slot_idx];
             }
         }
-        else {
-            std::vector <sai_map_data_t> new_list {};
 
-            for (i = 0; i < value->count; i++) {
-                new_list.push_back (value->data[i]);
-            }
-            g_sai_map.insert (std::make_pair (*key, new_list));
+        if (sai_hash_group_match (group, SAI_HASH_CTRL_EMPTY) != 0) {
+            break;
         }
     }
-    catch (...) {
-        rc = SAI_STATUS_FAILURE;
-    }
 
-    std_mutex_unlock (&sai_map_mutex);
-    return (rc);
+    return NULL;
 }
 
-sai_status_t sai_map_delete (sai_map_key_t *key)
+/* Writer only. Returns the first free slot in the probe sequence of 'hash'. */
+static uint32_t sai_map_slot_find_free (const sai_map_table_t *table, uint64_t hash)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
-
-    std_mutex_lock (&sai_map_mutex);
+    uint32_t group_idx;
+    uint32_t probe;
+    uint32_t match;
 
-    try {
-        auto map_it = g_sai_map.find (*key);
-        if (map_it != g_sai_map.end()) {
-            map_it->second.clear();
-            g_sai_map.erase (map_it);
+    SAI_HASH_FOR_EACH_PROBE_GROUP (table->group_count, hash, group_idx, probe) {
+        match = sai_hash_group_match_free (&table->ctrl [group_idx * SAI_HASH_GROUP_SIZE]);
+        if (match != 0) {
+            return (group_idx * SAI_HASH_GROUP_SIZE) + __builtin_ctz (match);
         }
     }
-    catch (...) {
-        rc = SAI_STATUS_FAILURE;
+
+    /* Unreachable, growth_left keeps at least one free slot per table */
+    return table->capacity;
+}
+
+/*
+ * Returns the slot of 'key' in the stripe. While the stripe is migrating,
+ * a key that has not been moved yet is found in the old table.
+ */
+static inline sai_map_slot_t *sai_map_shard_find (const sai_map_shard_t *shard,
+                                                  const sai_map_key_t *key, uint64_t hash)
+{
+    sai_map_slot_t *slot;
+
+    slot = sai_map_slot_find (shard->table.load (std::memory_order_acquire), key, hash);
+    if (slot == NULL) {
+        slot = sai_map_slot_find (shard->old_table.load (std::memory_order_acquire),
+                                  key, hash);
     }
 
-    std_mutex_unlock (&sai_map_mutex);
-    return rc;
+    return slot;
 }
 
-sai_status_t sai_map_delete_elements (sai_map_key_t        *key,
-                                      sai_map_val_t        *value,
-                                      sai_map_val_filter_t  filter)
+/* Number of elements a reader may access in 'list' */
+static inline uint32_t sai_map_list_count (const sai_map_list_t *list)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
-    uint32_t     i;
-    uint32_t     position;
+    uint32_t count = list->count.load (std::memory_order_acquire);
 
-    std_mutex_lock (&sai_map_mutex);
-
-    try {
-        auto map_it = g_sai_map.find (*key);
-        if (map_it != g_sai_map.end()) {
-            std::vector <sai_map_data_t>& list = map_it->second;
-
-            for (i = 0; i < value->count; i++) {
-                position = 0;
-                for (auto data: list) {
-                    if (sai_map_apply_filter (&value->data[i],
-                                                  &data, filter)) {
-                        list.erase (list.begin() + position);
-                        break;
-                    }
-                    position++;
-                }
-            }
-        }
+    return (count > list->capacity) ? list->capacity : count;
+}
+
+static inline void sai_map_slot_view (const sai_map_slot_t *slot, sai_map_view_t *view)
+{
+    const sai_map_list_t *list = slot->list.load (std::memory_order_acquire);
+    uint32_t              count;
+
+    view->list = list;
+
+    if (list != NULL) {
+        view->data  = list->data;
+        view->count = sai_map_list_count (list);
     }
-    catch (...) {
-        rc = SAI_STATUS_FAILURE;
+    else {
+        count       = slot->inline_count.load (std::memory_order_acquire);
+        view->data  = slot->inline_data;
+        view->count = (count > SAI_MAP_INLINE_COUNT) ? SAI_MAP_INLINE_COUNT : count;
+    }
+}
+
+/*
+ * Runs 'read_fn' on the values of 'key' (NULL if absent) without taking the
+ * stripe mutex. 'read_fn' may be invoked more than once if a writer updates
+ * the stripe concurrently, so it must only produce output that the next
+ * invocation fully overwrites.
+ */
+template <typename F>
+static sai_status_t sai_map_read (sai_map_shard_t *shard, const sai_map_key_t *key,
+                                  uint64_t hash, F read_fn)
+{
+    sai_map_slot_t *slot;
+    sai_map_view_t  view;
+    sai_status_t    rc;
+    uint32_t        seq;
+
+    if (!sai_epoch_read_lock ()) {
+        sai_map_stripe_lock (shard);
+        slot = sai_map_shard_find (shard, key, hash);
+        if (slot != NULL) {
+            sai_map_slot_view (slot, &view);
+        }
+        rc   = read_fn ((slot == NULL) ? NULL : &view);
+        sai_map_stripe_unlock (shard);
+        sai_map_stats_lookup (key->type, (slot != NULL));
+        return rc;
     }
 
-    std_mutex_unlock (&sai_map_mutex);
+    do {
+        seq  = sai_map_read_seq_begin (shard);
+        slot = sai_map_shard_find (shard, key, hash);
+        if (slot != NULL) {
+            sai_map_slot_view (slot, &view);
+        }
+        rc   = read_fn ((slot == NULL) ? NULL : &view);
+    } while (sai_map_read_seq_retry (shard, seq));
+
+    sai_epoch_read_unlock ();
+    sai_map_stats_lookup (key->type, (slot != NULL));
 
     return rc;
 }
 
-sai_status_t sai_map_get (sai_map_key_t *key, sai_map_val_t *value)
+static sai_map_list_t *sai_map_list_alloc (uint32_t capacity)
 {
-    uint32_t     count;
-    uint32_t     i;
-    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_map_list_t *list;
+    size_t          data_size;
+    uint32_t        index_size = 0;
 
-    std_mutex_lock (&sai_map_mutex);
+    if (capacity < SAI_MAP_LIST_MIN_CAPACITY) {
+        capacity = SAI_MAP_LIST_MIN_CAPACITY;
+    }
 
-    try {
-        auto map_it = g_sai_map.find (*key);
-        if (map_it != g_sai_map.end()) {
-            std::vector <sai_map_data_t>& list = map_it->second;
+    /* Keep the index at most half full */
+    if (capacity >= SAI_MAP_INDEX_MIN_CAPACITY) {
+        for (index_size = 1; index_size < (2 * capacity); index_size <<= 1);
+    }
 
-            count = list.size();
+    data_size = sizeof (sai_map_list_t) + ((capacity - 1) * sizeof (sai_map_data_t));
 
-            if (count > value->count) {
-                /*
-                 * The passed buffer is insufficient. So fill
-                 * the count with the actual number of elements,
-                 * so that the caller will call with sufficient
-                 * memory again.
-                 */
-                rc = SAI_STATUS_BUFFER_OVERFLOW;
-            }
-            else {
-                for (i = 0; i < count; i++) {
-                    value->data[i] = list.at(i);
-                }
-            }
+    list = (sai_map_list_t *) calloc (1, data_size + (index_size * sizeof (uint32_t)));
+    if (list != NULL) {
+        list->capacity = capacity;
 
-            value->count = count;
-        }
-        else {
-            rc = SAI_STATUS_ITEM_NOT_FOUND;
+        if (index_size != 0) {
+            list->index_mask = index_size - 1;
+            list->index      = (uint32_t *) ((uint8_t *) list + data_size);
         }
     }
-    catch (...) {
-        rc = SAI_STATUS_FAILURE;
-    }
 
-    std_mutex_unlock (&sai_map_mutex);
-    return rc;
+    return list;
 }
 
-sai_status_t sai_map_get_element_at_index (const sai_map_key_t *key,
-                                           uint32_t index,
-                                           sai_map_val_t *value)
+static inline uint32_t sai_map_index_bucket (const sai_map_list_t *list, sai_object_id_t val1)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
+    return (uint32_t) sai_hash_mix64 (val1) & list->index_mask;
+}
 
-    if((value == NULL) || (key == NULL)) {
-       return SAI_STATUS_INVALID_PARAMETER;
+/* Writer only. Adds positions [from, to) of the list to its index. */
+static void sai_map_index_add (sai_map_list_t *list, uint32_t from, uint32_t to)
+{
+    uint32_t bucket;
+    uint32_t pos;
+
+    if (list->index_mask == 0) {
+        return;
     }
 
-    std_mutex_lock (&sai_map_mutex);
+    for (pos = from; pos < to; pos++) {
+        bucket = sai_map_index_bucket (list, list->data [pos].val1);
+        while (list->index [bucket] != 0) {
+            bucket = (bucket + 1) & list->index_mask;
+        }
+        list->index [bucket] = pos + 1;
+    }
+}
+
+/* Writer only. Returns the bucket holding position 'pos'. */
+static uint32_t sai_map_index_bucket_of (const sai_map_list_t *list, uint32_t pos)
+{
+    uint32_t bucket = sai_map_index_bucket (list, list->data [pos].val1);
 
-    try {
-        auto map_it = g_sai_map.find (*key);
-        if (map_it != g_sai_map.end()) {
-            std::vector <sai_map_data_t>& list = map_it->second;
+    while (list->index [bucket] != (pos + 1)) {
+        bucket = (bucket + 1) & list->index_mask;
+    }
 
-            if (index >= list.size()) {
-                rc = SAI_STATUS_INVALID_PARAMETER;
-            }
-            else {
-                value->data[0] = list.at(index);
-            }
+    return bucket;
+}
+
+/*
+ * Writer only. Removes the element at 'pos' from an indexed list of
+ * 'count' elements, moving the last element into its place.
+ */
+static void sai_map_index_remove (sai_map_list_t *list, uint32_t pos, uint32_t count)
+{
+    uint32_t hole = sai_map_index_bucket_of (list, pos);
+    uint32_t bucket = hole;
+    uint32_t home;
+    uint32_t last = count - 1;
 
+    /* Backward shift deletion, so that probe sequences need no markers */
+    for (;;) {
+        bucket = (bucket + 1) & list->index_mask;
+        if (list->index [bucket] == 0) {
+            break;
         }
-        else {
-            rc = SAI_STATUS_ITEM_NOT_FOUND;
+
+        home = sai_map_index_bucket (list, list->data [list->index [bucket] - 1].val1);
+        if (((bucket - home) & list->index_mask) >= ((bucket - hole) & list->index_mask)) {
+            list->index [hole] = list->index [bucket];
+            hole = bucket;
         }
     }
-    catch (...) {
-        rc = SAI_STATUS_FAILURE;
+    list->index [hole] = 0;
+
+    if (pos != last) {
+        list->index [sai_map_index_bucket_of (list, last)] = pos + 1;
+        list->data [pos] = list->data [last];
     }
+}
 
-    std_mutex_unlock (&sai_map_mutex);
-    return rc;
+/* Number of keys a table of 'group_count' groups takes before a rebuild */
+static inline uint32_t sai_map_table_max_size (uint32_t group_count)
+{
+    uint32_t capacity = group_count * SAI_HASH_GROUP_SIZE;
+
+    return capacity - (capacity / 8);
 }
-sai_status_t sai_map_get_elements (sai_map_key_t        *key,
-                                   sai_map_val_t        *value,
-                                   sai_map_val_filter_t  filter)
+
+static sai_map_table_t *sai_map_table_alloc (uint32_t group_count)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
-    uint32_t     i;
+    sai_map_table_t *table;
+    uint32_t         capacity = group_count * SAI_HASH_GROUP_SIZE;
 
-    std_mutex_lock (&sai_map_mutex);
-
-    try {
-        auto map_it = g_sai_map.find (*key);
-        if (map_it != g_sai_map.end()) {
-            std::vector <sai_map_data_t>& list = map_it->second;
-
-            for (i = 0; i < value->count; i++) {
-                for (auto data: list) {
-                    if (sai_map_apply_filter (&value->data[i],
-                                                  &data, filter)) {
-                        sai_map_copy_value (&value->data[i],
-                                                &data, filter);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-    catch (...) {
-        rc = SAI_STATUS_FAILURE;
+    table = (sai_map_table_t *) calloc (1, sizeof (sai_map_table_t) + capacity +
+                                        (capacity * sizeof (sai_map_slot_t)));
+    if (table == NULL) {
+        return NULL;
     }
 
-    std_mutex_unlock (&sai_map_mutex);
+    table->group_count = group_count;
+    table->capacity    = capacity;
+    table->growth_left = sai_map_table_max_size (group_count);
+    table->slots       = (sai_map_slot_t *) (table + 1);
+    table->ctrl        = (int8_t *) (table->slots + capacity);
 
-    return rc;
+    memset (table->ctrl, SAI_HASH_CTRL_EMPTY, capacity);
+
+    return table;
 }
 
-sai_status_t sai_map_get_val_count (sai_map_key_t *key, uint32_t *p_out_count)
+/* Writer only. Moves the key in 'slot' into 'table'. */
+static void sai_map_slot_move (sai_map_table_t *table, sai_map_slot_t *slot)
 {
-    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_map_slot_t *new_slot;
+    sai_map_key_t   key;
+    uint32_t        free_idx;
+    uint64_t        hash;
 
-    std_mutex_lock (&sai_map_mutex);
+    sai_map_slot_key_get (slot, &key);
+    hash     = _sai_map_hash()(key);
+    free_idx = sai_map_slot_find_free (table, hash);
+    new_slot = &table->slots [free_idx];
 
-    try {
-        auto map_it = g_sai_map.find (*key);
-        if (map_it != g_sai_map.end()) {
-            std::vector <sai_map_data_t>& list = map_it->second;
+    new_slot->type = slot->type;
+    new_slot->id1  = slot->id1;
+    new_slot->id2  = slot->id2;
+    new_slot->list.store (slot->list.load (std::memory_order_relaxed),
+                          std::memory_order_relaxed);
+    new_slot->inline_count.store (slot->inline_count.load (std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+    memcpy (new_slot->inline_data, slot->inline_data, sizeof (slot->inline_data));
 
-            *p_out_count = list.size();
-        }
-        else {
-            rc = SAI_STATUS_ITEM_NOT_FOUND;
+    if (table->ctrl [free_idx] == SAI_HASH_CTRL_EMPTY) {
+        table->growth_left--;
+    }
+    table->ctrl [free_idx] = sai_hash_h2 (hash);
+}
+
+/*
+ * Writer only, within a write section. Moves the keys of up to 'slot_count'
+ * slots of the old table into the current one, and retires the old table
+ * once it is empty. Readers look in both tables until then.
+ */
+static void sai_map_table_migrate (sai_map_shard_t *shard, uint32_t slot_count)
+{
+    sai_map_table_t *old_table = shard->old_table.load (std::memory_order_relaxed);
+    sai_map_table_t *table = shard->table.load (std::memory_order_relaxed);
+    uint32_t         end;
+
+    if (old_table == NULL) {
+        return;
+    }
+
+    end = old_table->capacity - shard->migrate_pos;
+    end = shard->migrate_pos + ((slot_count < end) ? slot_count : end);
+
+    for (; (shard->migrate_pos < end) && (shard->migrate_left > 0); shard->migrate_pos++) {
+        if (old_table->ctrl [shard->migrate_pos] < 0) {
+            continue;
         }
+
+        sai_map_slot_move (table, &old_table->slots [shard->migrate_pos]);
+        old_table->ctrl [shard->migrate_pos] = SAI_HASH_CTRL_DELETED;
+        shard->migrate_left--;
     }
-    catch (...) {
-        rc = SAI_STATUS_FAILURE;
+
+    if (shard->migrate_left == 0) {
+        shard->old_table.store (NULL, std::memory_order_release);
+        sai_map_retire (shard, old_table);
+        shard->reclaim_now = true;
     }
+}
 
-    std_mutex_unlock (&sai_map_mutex);
-    return rc;
+/*
+ * Makes room for 'count' more keys. When the table runs out of free slots
+ * a new one is allocated, doubled if the stripe is more than half full, or
+ * at the same size to drop deleted markers otherwise, and grown further if
+ * that is still not enough. The keys are then moved over a few slots per
+ * update by sai_map_table_migrate(), so that no single update pays for
+ * rehashing the whole stripe. Keys not moved yet count against the room
+ * left in the new table.
+ */
+static sai_status_t sai_map_table_reserve (sai_map_shard_t *shard, uint32_t count)
+{
+    sai_map_table_t *old_table = shard->table.load (std::memory_order_relaxed);
+    sai_map_table_t *new_table;
+    uint32_t         group_count = 1;
+
+    if (old_table != NULL) {
+        if (old_table->growth_left >= (count + shard->migrate_left)) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        /* Growing again mid-migration, finish the previous one first */
+        sai_map_table_migrate (shard, UINT32_MAX);
+
+        if (old_table->growth_left >= count) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        group_count = old_table->group_count;
+        if ((shard->size + count) > (old_table->capacity / 2)) {
+            group_count *= 2;
+        }
+    }
+
+    while ((shard->size + count) > sai_map_table_max_size (group_count)) {
+        group_count *= 2;
+    }
+
+    new_table = sai_map_table_alloc (group_count);
+    if (new_table == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    if (old_table != NULL) {
+        shard->migrate_pos  = 0;
+        shard->migrate_left = shard->size;
+        shard->old_table.store (old_table, std::memory_order_release);
+    }
+
+    shard->table.store (new_table, std::memory_order_release);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Writer only. Returns the slot for 'key', or NULL if absent. */
+static inline sai_map_slot_t *sai_map_slot_lookup (sai_map_shard_t *shard,
+                                                   const sai_map_key_t *key, uint64_t hash)
+{
+    return sai_map_shard_find (shard, key, hash);
+}
+
+/*
+ * Writer only. Returns the list of 'slot' ready to be modified in place.
+ * A list that an open cursor holds a snapshot of is copied first, and the
+ * snapshot is reclaimed once the last cursor on it is closed.
+ */
+static sai_map_list_t *sai_map_list_unshare (sai_map_shard_t *shard, sai_map_slot_t *slot)
+{
+    sai_map_list_t *list = slot->list.load (std::memory_order_relaxed);
+    sai_map_list_t *copy;
+    uint32_t        count;
+
+    /* Pairs with the fence in sai_map_cursor_open() */
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    if (list->hdr.pins.load (std::memory_order_relaxed) == 0) {
+        return list;
+    }
+
+    copy = sai_map_list_alloc (list->capacity);
+    if (copy == NULL) {
+        return NULL;
+    }
+
+    count = list->count.load (std::memory_order_relaxed);
+    memcpy (copy->data, list->data, count * sizeof (sai_map_data_t));
+    sai_map_index_add (copy, 0, count);
+    copy->count.store (count, std::memory_order_relaxed);
+
+    slot->list.store (copy, std::memory_order_release);
+    sai_map_retire (shard, list);
+
+    return copy;
+}
+
+static bool sai_map_apply_filter (const sai_map_data_t *arg1,
+                                      const sai_map_data_t *arg2,
+                                      sai_map_val_filter_t  filter)
+{
+    if ((filter & SAI_MAP_VAL_FILTER_NONE) == SAI_MAP_VAL_FILTER_NONE) {
+        return true;
+    }
+
+    if ((filter & SAI_MAP_VAL_FILTER_VAL1) == SAI_MAP_VAL_FILTER_VAL1) {
+        if (arg1->val1 != arg2->val1) {
+            return false;
+        }
+    }
+
+    if ((filter & SAI_MAP_VAL_FILTER_VAL2) == SAI_MAP_VAL_FILTER_VAL2) {
+        if (arg1->val2 != arg2->val2) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void sai_map_copy_value (sai_map_data_t       *dst,
+                                    sai_map_data_t       *src,
+                                    sai_map_val_filter_t  filter)
+{
+    if ((filter & SAI_MAP_VAL_FILTER_NONE) == SAI_MAP_VAL_FILTER_NONE) {
+        *dst = *src;
+        return;
+    }
+
+    if ((filter & SAI_MAP_VAL_FILTER_VAL1) == SAI_MAP_VAL_FILTER_VAL1) {
+        dst->val1 = src->val1;
+    }
+
+    if ((filter & SAI_MAP_VAL_FILTER_VAL2) == SAI_MAP_VAL_FILTER_VAL2) {
+        dst->val2 = src->val2;
+    }
+}
+
+/*
+ * Returns the lowest position in 'view' whose element matches 'data' under
+ * 'filter', or the view count if none does. Lookups on val1 go through the
+ * list index when there is one. The walk is bounded, so that a reader
+ * racing a writer terminates and then fails validation.
+ */
+static uint32_t sai_map_view_find (const sai_map_view_t *view, const sai_map_data_t *data,
+                                   sai_map_val_filter_t filter)
+{
+    const sai_map_list_t *list = view->list;
+    uint32_t count = view->count;
+    uint32_t found = count;
+    uint32_t bucket;
+    uint32_t probe;
+    uint32_t pos;
+
+    if ((list == NULL) || (list->index_mask == 0) ||
+        ((filter & SAI_MAP_VAL_FILTER_NONE) == SAI_MAP_VAL_FILTER_NONE) ||
+        ((filter & SAI_MAP_VAL_FILTER_VAL1) != SAI_MAP_VAL_FILTER_VAL1)) {
+        for (pos = 0; pos < count; pos++) {
+            if (sai_map_apply_filter (data, &view->data [pos], filter)) {
+                return pos;
+            }
+        }
+        return count;
+    }
+
+    bucket = sai_map_index_bucket (list, data->val1);
+
+    for (probe = 0; probe <= list->index_mask; probe++) {
+        pos = list->index [bucket];
+        if (pos == 0) {
+            break;
+        }
+        pos--;
+
+        if ((pos < found) && sai_map_apply_filter (data, &list->data [pos], filter)) {
+            found = pos;
+        }
+        bucket = (bucket + 1) & list->index_mask;
+    }
+
+    return found;
+}
+
+/*
+ * Reverse index, from val1 back to the keys whose list holds it. Only the
+ * types listed below maintain one. It is updated by the writers with the
+ * stripe mutex held, so it always matches the forward map. Its own lock is
+ * always taken after a stripe lock, never before one. Types of the object
+ * relation store keep their reverse index there.
+ */
+static const sai_map_type_t g_sai_map_reverse_types [] = {
+    SAI_MAP_TYPE_NH_GRP_2_MEMBER_LIST,
+    SAI_MAP_TYPE_TUNNEL_MAP_TO_TUNNEL_LIST,
+    SAI_MAP_TYPE_BRIDGE_TUNNEL_TO_BRIDGE_PORT_LIST,
+};
+
+struct sai_map_reverse_ref_t {
+    sai_map_key_t key;
+
+    /* Number of elements with this val1 in the list of 'key' */
+    uint32_t      ref_count;
+};
+
+typedef std::unordered_map<sai_object_id_t, std::vector<sai_map_reverse_ref_t>> sai_map_reverse_index_t;
+
+struct sai_map_reverse_t {
+    bool                     enabled;
+    std_mutex_type_t         mutex;
+    sai_map_reverse_index_t  index;
+
+    sai_map_reverse_t () : enabled (false) {
+        std_mutex_lock_init_non_recursive (&mutex);
+    }
+};
+
+static sai_map_reverse_t *sai_map_reverse_init (void)
+{
+    static sai_map_reverse_t reverse [SAI_MAP_TYPE_MAX];
+    uint32_t                 idx;
+
+    for (idx = 0; idx < (sizeof (g_sai_map_reverse_types) /
+                         sizeof (g_sai_map_reverse_types [0])); idx++) {
+        reverse [g_sai_map_reverse_types [idx]].enabled = true;
+    }
+
+    return reverse;
+}
+
+static sai_map_reverse_t *sai_map_reverse_get (sai_map_type_t type)
+{
+    static sai_map_reverse_t *reverse = sai_map_reverse_init ();
+
+    return (reverse [type].enabled) ? &reverse [type] : NULL;
+}
+
+static inline bool sai_map_key_equal (const sai_map_key_t *key1, const sai_map_key_t *key2)
+{
+    return ((key1->type == key2->type) &&
+            (key1->id1 == key2->id1) && (key1->id2 == key2->id2));
+}
+
+/* Drops one reference from each of 'count' elements to 'key' */
+static void sai_map_reverse_remove (sai_map_reverse_t *reverse, const sai_map_key_t *key,
+                                    const sai_map_data_t *data, uint32_t count)
+{
+    uint32_t i;
+
+    std_mutex_lock (&reverse->mutex);
+
+    for (i = 0; i < count; i++) {
+        auto map_it = reverse->index.find (data [i].val1);
+        if (map_it == reverse->index.end ()) {
+            continue;
+        }
+
+        std::vector<sai_map_reverse_ref_t> &refs = map_it->second;
+
+        for (auto ref_it = refs.begin (); ref_it != refs.end (); ref_it++) {
+            if (sai_map_key_equal (&ref_it->key, key)) {
+                if (--ref_it->ref_count == 0) {
+                    *ref_it = refs.back ();
+                    refs.pop_back ();
+                }
+                break;
+            }
+        }
+
+        if (refs.empty ()) {
+            reverse->index.erase (map_it);
+        }
+    }
+
+    std_mutex_unlock (&reverse->mutex);
+}
+
+/* Adds a reference from each of 'count' elements to 'key'. All or nothing. */
+static sai_status_t sai_map_reverse_add (sai_map_reverse_t *reverse, const sai_map_key_t *key,
+                                         const sai_map_data_t *data, uint32_t count)
+{
+    sai_map_reverse_ref_t new_ref;
+    uint32_t              i;
+    bool                  found;
+
+    memset (&new_ref, 0, sizeof (new_ref));
+    new_ref.key       = *key;
+    new_ref.ref_count = 1;
+
+    std_mutex_lock (&reverse->mutex);
+
+    for (i = 0; i < count; i++) {
+        try {
+            std::vector<sai_map_reverse_ref_t> &refs = reverse->index [data [i].val1];
+
+            found = false;
+            for (auto ref_it = refs.begin (); ref_it != refs.end (); ref_it++) {
+                if (sai_map_key_equal (&ref_it->key, key)) {
+                    ref_it->ref_count++;
+                    found = true;
+                    break;
+                }
+            }
+
+            if (!found) {
+                refs.push_back (new_ref);
+            }
+        }
+        catch (...) {
+            auto map_it = reverse->index.find (data [i].val1);
+            if ((map_it != reverse->index.end ()) && map_it->second.empty ()) {
+                reverse->index.erase (map_it);
+            }
+            std_mutex_unlock (&reverse->mutex);
+            sai_map_reverse_remove (reverse, key, data, i);
+            return SAI_STATUS_NO_MEMORY;
+        }
+    }
+
+    std_mutex_unlock (&reverse->mutex);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Writer bodies. They run with the stripe mutex held and the stripe write
+ * section open, so that bulk callers can apply a whole batch in one go.
+ */
+
+/*
+ * Appends the elements of 'value' to 'key'. 'reserve' is the number of
+ * elements the caller is about to append to the key in total, at least
+ * value->count, and sizes any list that has to be allocated.
+ */
+static sai_status_t sai_map_insert_locked (sai_map_shard_t *shard, const sai_map_key_t *key,
+                                           uint64_t hash, const sai_map_val_t *value,
+                                           uint32_t reserve)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_map_table_t *table;
+    sai_map_slot_t  *slot;
+    sai_map_list_t  *list;
+    sai_map_list_t  *new_list;
+    sai_map_data_t  *elems;
+    sai_map_reverse_t *reverse;
+    uint32_t     count;
+    uint32_t     capacity;
+    uint32_t     slot_idx;
+
+    if (reserve < value->count) {
+        reserve = value->count;
+    }
+
+    reverse = sai_map_reverse_get (key->type);
+
+    if (reverse != NULL) {
+        rc = sai_map_reverse_add (reverse, key, value->data, value->count);
+        if (rc != SAI_STATUS_SUCCESS) {
+            return rc;
+        }
+    }
+
+    slot = sai_map_slot_lookup (shard, key, hash);
+
+    if (slot != NULL) {
+        list = slot->list.load (std::memory_order_relaxed);
+
+        if (list != NULL) {
+            elems    = list->data;
+            count    = list->count.load (std::memory_order_relaxed);
+            capacity = list->capacity;
+        }
+        else {
+            elems    = slot->inline_data;
+            count    = slot->inline_count.load (std::memory_order_relaxed);
+            capacity = SAI_MAP_INLINE_COUNT;
+        }
+
+        if ((count + value->count) > capacity) {
+            new_list = sai_map_list_alloc (2 * (count + reserve));
+
+            if (new_list == NULL) {
+                rc = SAI_STATUS_NO_MEMORY;
+            }
+            else {
+                memcpy (new_list->data, elems, count * sizeof (sai_map_data_t));
+                memcpy (&new_list->data [count], value->data,
+                        value->count * sizeof (sai_map_data_t));
+                sai_map_index_add (new_list, 0, count + value->count);
+                new_list->count.store (count + value->count, std::memory_order_relaxed);
+
+                slot->list.store (new_list, std::memory_order_release);
+                sai_map_retire (shard, list);
+                sai_map_stripe_counters_update (shard, 0, value->count, count + value->count);
+            }
+        }
+        else {
+            memcpy (&elems [count], value->data, value->count * sizeof (sai_map_data_t));
+
+            if (list != NULL) {
+                sai_map_index_add (list, count, count + value->count);
+                list->count.store (count + value->count, std::memory_order_release);
+            }
+            else {
+                slot->inline_count.store (count + value->count, std::memory_order_release);
+            }
+            sai_map_stripe_counters_update (shard, 0, value->count, count + value->count);
+        }
+    }
+    else {
+        list = NULL;
+
+        if (reserve > SAI_MAP_INLINE_COUNT) {
+            list = sai_map_list_alloc (reserve);
+
+            if (list == NULL) {
+                rc = SAI_STATUS_NO_MEMORY;
+            }
+        }
+
+        if (rc == SAI_STATUS_SUCCESS) {
+            rc = sai_map_table_reserve (shard, 1);
+        }
+
+        if (rc != SAI_STATUS_SUCCESS) {
+            free (list);
+        }
+        else {
+            table    = shard->table.load (std::memory_order_relaxed);
+            slot_idx = sai_map_slot_find_free (table, hash);
+            slot     = &table->slots [slot_idx];
+
+            if (table->ctrl [slot_idx] == SAI_HASH_CTRL_EMPTY) {
+                table->growth_left--;
+            }
+
+            /* Values are written straight into their final storage */
+            if (list != NULL) {
+                memcpy (list->data, value->data, value->count * sizeof (sai_map_data_t));
+                sai_map_index_add (list, 0, value->count);
+                list->count.store (value->count, std::memory_order_relaxed);
+                slot->inline_count.store (0, std::memory_order_relaxed);
+            }
+            else {
+                memcpy (slot->inline_data, value->data, value->count * sizeof (sai_map_data_t));
+                slot->inline_count.store (value->count, std::memory_order_relaxed);
+            }
+
+            slot->type = (uint32_t) key->type;
+            slot->id1  = key->id1;
+            slot->id2  = key->id2;
+            slot->list.store (list, std::memory_order_release);
+            table->ctrl [slot_idx] = sai_hash_h2 (hash);
+            shard->size++;
+            sai_map_stripe_counters_update (shard, 1, value->count, value->count);
+        }
+    }
+
+    if ((rc != SAI_STATUS_SUCCESS) && (reverse != NULL)) {
+        sai_map_reverse_remove (reverse, key, value->data, value->count);
+    }
+
+    return (rc);
+}
+
+static void sai_map_delete_locked (sai_map_shard_t *shard, const sai_map_key_t *key,
+                                   uint64_t hash)
+{
+    sai_map_table_t *table;
+    sai_map_slot_t  *slot;
+    sai_map_reverse_t *reverse;
+    sai_map_view_t   view;
+    uint32_t     slot_idx;
+    int8_t      *group;
+
+    slot = sai_map_slot_lookup (shard, key, hash);
+    if (slot == NULL) {
+        return;
+    }
+
+    table = shard->table.load (std::memory_order_relaxed);
+    if ((slot < table->slots) || (slot >= &table->slots [table->capacity])) {
+        /* Not moved yet, it is dropped from the old table */
+        table = shard->old_table.load (std::memory_order_relaxed);
+        shard->migrate_left--;
+    }
+
+    slot_idx = slot - table->slots;
+    group    = &table->ctrl [slot_idx - (slot_idx % SAI_HASH_GROUP_SIZE)];
+
+    /*
+     * A group that still has an empty slot never made a probe move on
+     * to the next group, so the slot can go back to empty. Otherwise
+     * it must stay a deleted marker to keep later keys reachable.
+     */
+    if (sai_hash_group_match (group, SAI_HASH_CTRL_EMPTY) != 0) {
+        table->ctrl [slot_idx] = SAI_HASH_CTRL_EMPTY;
+        table->growth_left++;
+    }
+    else {
+        table->ctrl [slot_idx] = SAI_HASH_CTRL_DELETED;
+    }
+
+    sai_map_slot_view (slot, &view);
+
+    reverse = sai_map_reverse_get (key->type);
+    if (reverse != NULL) {
+        sai_map_reverse_remove (reverse, key, view.data, view.count);
+    }
+
+    sai_map_retire (shard, slot->list.load (std::memory_order_relaxed));
+    slot->list.store (NULL, std::memory_order_release);
+    slot->inline_count.store (0, std::memory_order_release);
+    shard->size--;
+    sai_map_stripe_counters_update (shard, -1, -((int64_t) view.count), 0);
+}
+
+static sai_status_t sai_map_delete_elements_locked (sai_map_shard_t      *shard,
+                                                    const sai_map_key_t  *key,
+                                                    uint64_t              hash,
+                                                    const sai_map_val_t  *value,
+                                                    sai_map_val_filter_t  filter)
+{
+    sai_map_slot_t  *slot;
+    sai_map_list_t  *list;
+    sai_map_data_t  *elems;
+    sai_map_view_t   view;
+    sai_map_reverse_t *reverse;
+    uint32_t     count;
+    uint32_t     old_count;
+    uint32_t     i;
+    uint32_t     position;
+
+    slot = sai_map_slot_lookup (shard, key, hash);
+    if (slot == NULL) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    list = slot->list.load (std::memory_order_relaxed);
+
+    if (list != NULL) {
+        list = sai_map_list_unshare (shard, slot);
+        if (list == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+        elems = list->data;
+        count = list->count.load (std::memory_order_relaxed);
+    }
+    else {
+        elems = slot->inline_data;
+        count = slot->inline_count.load (std::memory_order_relaxed);
+    }
+
+    view.data = elems;
+    view.list = list;
+    reverse   = sai_map_reverse_get (key->type);
+    old_count = count;
+
+    for (i = 0; i < value->count; i++) {
+        view.count = count;
+        position   = sai_map_view_find (&view, &value->data[i], filter);
+        if (position >= count) {
+            continue;
+        }
+
+        if (reverse != NULL) {
+            sai_map_reverse_remove (reverse, key, &elems [position], 1);
+        }
+
+        if ((list != NULL) && (list->index_mask != 0)) {
+            sai_map_index_remove (list, position, count);
+        }
+        else {
+            memmove (&elems [position], &elems [position + 1],
+                     (count - position - 1) * sizeof (sai_map_data_t));
+        }
+        count--;
+    }
+
+    if (list != NULL) {
+        list->count.store (count, std::memory_order_release);
+    }
+    else {
+        slot->inline_count.store (count, std::memory_order_release);
+    }
+    sai_map_stripe_counters_update (shard, 0, -((int64_t) (old_count - count)), 0);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* One entry of a bulk request, located in its stripe */
+struct sai_map_bulk_entry_t {
+    sai_map_shard_t *shard;
+    uint64_t         hash;
+    uint32_t         index;
+    /* Elements the batch adds to the key from this entry on */
+    uint32_t         reserve;
+};
+
+/*
+ * Locates every entry of a bulk request and groups the entries by stripe
+ * with a counting sort, keeping the request order within a stripe. Entries
+ * with an invalid key get their status set and are left out. The entries
+ * array must hold 2 * count elements; returns the grouped entries and sets
+ * valid to their number.
+ */
+static sai_map_bulk_entry_t *sai_map_bulk_prepare (uint32_t count,
+                                                   const sai_map_key_t *key_list,
+                                                   sai_map_bulk_entry_t *entries,
+                                                   sai_status_t *status_list,
+                                                   uint32_t *valid)
+{
+    sai_map_bulk_entry_t *sorted = entries + count;
+    uint32_t offset [SAI_MAP_STRIPE_COUNT + 1];
+    uint32_t stripe;
+    uint32_t idx;
+    uint32_t num = 0;
+
+    memset (offset, 0, sizeof (offset));
+
+    for (idx = 0; idx < count; idx++) {
+        entries [num].shard = sai_map_shard_get (&key_list [idx], &entries [num].hash);
+        entries [num].index = idx;
+        entries [num].reserve = 0;
+
+        if (entries [num].shard == NULL) {
+            status_list [idx] = SAI_STATUS_INVALID_PARAMETER;
+            continue;
+        }
+        status_list [idx] = SAI_STATUS_SUCCESS;
+        offset [sai_map_stripe_index (entries [num].shard) + 1]++;
+        num++;
+    }
+
+    for (stripe = 0; stripe < SAI_MAP_STRIPE_COUNT; stripe++) {
+        offset [stripe + 1] += offset [stripe];
+    }
+
+    for (idx = 0; idx < num; idx++) {
+        sorted [offset [sai_map_stripe_index (entries [idx].shard)]++] = entries [idx];
+    }
+
+    *valid = num;
+    return sorted;
+}
+
+/*
+ * Sets the reserve of every entry of one stripe run to the number of
+ * elements the run adds to its key from that entry on, walking the run
+ * backwards through a scratch open addressing table of the last entry seen
+ * per key. The buckets array must hold a power of two >= 2 * num elements.
+ * Returns the number of distinct keys in the run.
+ */
+static uint32_t sai_map_bulk_group (sai_map_bulk_entry_t *run, uint32_t num,
+                                    const sai_map_key_t *key_list,
+                                    const sai_map_val_t *value_list,
+                                    uint32_t *buckets)
+{
+    uint32_t mask = 1;
+    uint32_t key_count = 0;
+    uint32_t bucket;
+    uint32_t idx;
+
+    while (mask < (2 * num)) {
+        mask <<= 1;
+    }
+    memset (buckets, 0, mask * sizeof (uint32_t));
+    mask--;
+
+    for (idx = num; idx-- > 0;) {
+        run [idx].reserve = value_list [run [idx].index].count;
+
+        for (bucket = (uint32_t) run [idx].hash & mask; buckets [bucket] != 0;
+             bucket = (bucket + 1) & mask) {
+            const sai_map_bulk_entry_t *last = &run [buckets [bucket] - 1];
+
+            if ((last->hash == run [idx].hash) &&
+                sai_map_key_equal (&key_list [last->index], &key_list [run [idx].index])) {
+                run [idx].reserve += last->reserve;
+                break;
+            }
+        }
+
+        if (buckets [bucket] == 0) {
+            key_count++;
+        }
+        buckets [bucket] = idx + 1;
+    }
+
+    return key_count;
+}
+
+extern "C" {
+
+sai_status_t sai_map_insert (sai_map_key_t *key, sai_map_val_t *value)
+{
+    sai_status_t rc;
+    sai_map_shard_t *shard;
+    uint64_t     hash = 0;
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_map_stripe_lock (shard);
+    sai_map_write_begin (shard);
+
+    rc = sai_map_insert_locked (shard, key, hash, value, value->count);
+
+    sai_map_write_end (shard);
+    sai_map_stripe_unlock (shard);
+    return (rc);
+}
+
+sai_status_t sai_map_delete (sai_map_key_t *key)
+{
+    sai_map_shard_t *shard;
+    uint64_t     hash = 0;
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_map_stripe_lock (shard);
+
+    if (sai_map_slot_lookup (shard, key, hash) != NULL) {
+        sai_map_write_begin (shard);
+        sai_map_delete_locked (shard, key, hash);
+        sai_map_write_end (shard);
+    }
+
+    sai_map_stripe_unlock (shard);
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_map_delete_elements (sai_map_key_t        *key,
+                                      sai_map_val_t        *value,
+                                      sai_map_val_filter_t  filter)
+{
+    sai_status_t rc = SAI_STATUS_SUCCESS;
+    sai_map_shard_t *shard;
+    uint64_t     hash = 0;
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    sai_map_stripe_lock (shard);
+
+    if (sai_map_slot_lookup (shard, key, hash) != NULL) {
+        sai_map_write_begin (shard);
+        rc = sai_map_delete_elements_locked (shard, key, hash, value, filter);
+        sai_map_write_end (shard);
+    }
+
+    sai_map_stripe_unlock (shard);
+
+    return rc;
+}
+
+sai_status_t sai_map_bulk_insert (uint32_t             count,
+                                  const sai_map_key_t *key_list,
+                                  const sai_map_val_t *value_list,
+                                  sai_status_t        *status_list)
+{
+    sai_map_bulk_entry_t *entries;
+    sai_map_bulk_entry_t *sorted;
+    sai_map_shard_t      *shard;
+    sai_status_t          rc = SAI_STATUS_SUCCESS;
+    uint32_t             *buckets;
+    uint32_t              valid = 0;
+    uint32_t              start;
+    uint32_t              end;
+    uint32_t              idx;
+    uint32_t              key_count;
+
+    if ((count == 0) || (key_list == NULL) || (value_list == NULL) || (status_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    entries = (sai_map_bulk_entry_t *) calloc (2 * (size_t) count, sizeof (sai_map_bulk_entry_t));
+    buckets = (uint32_t *) calloc (4 * (size_t) count, sizeof (uint32_t));
+    if ((entries == NULL) || (buckets == NULL)) {
+        free (entries);
+        free (buckets);
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sorted = sai_map_bulk_prepare (count, key_list, entries, status_list, &valid);
+
+    for (start = 0; start < valid; start = end) {
+        shard = sorted [start].shard;
+
+        for (end = start; (end < valid) && (sorted [end].shard == shard); end++);
+
+        key_count = sai_map_bulk_group (&sorted [start], end - start, key_list,
+                                        value_list, buckets);
+
+        sai_map_stripe_lock (shard);
+        sai_map_write_begin (shard);
+
+        /* Best effort, each insert still makes room for its own key */
+        sai_map_table_reserve (shard, key_count);
+
+        for (idx = start; idx < end; idx++) {
+            status_list [sorted [idx].index] =
+                sai_map_insert_locked (shard, &key_list [sorted [idx].index],
+                                       sorted [idx].hash,
+                                       &value_list [sorted [idx].index],
+                                       sorted [idx].reserve);
+        }
+
+        sai_map_write_end (shard);
+        sai_map_stripe_unlock (shard);
+    }
+
+    free (buckets);
+    free (entries);
+
+    for (idx = 0; idx < count; idx++) {
+        if (status_list [idx] != SAI_STATUS_SUCCESS) {
+            rc = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return rc;
+}
+
+sai_status_t sai_map_bulk_delete (uint32_t             count,
+                                  const sai_map_key_t *key_list,
+                                  const sai_map_val_t *value_list,
+                                  sai_map_val_filter_t filter,
+                                  sai_status_t        *status_list)
+{
+    sai_map_bulk_entry_t *entries;
+    sai_map_bulk_entry_t *sorted;
+    sai_map_shard_t      *shard;
+    sai_status_t          rc = SAI_STATUS_SUCCESS;
+    uint32_t              valid = 0;
+    uint32_t              start;
+    uint32_t              end;
+    uint32_t              idx;
+
+    if ((count == 0) || (key_list == NULL) || (status_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    entries = (sai_map_bulk_entry_t *) calloc (2 * (size_t) count, sizeof (sai_map_bulk_entry_t));
+    if (entries == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    sorted = sai_map_bulk_prepare (count, key_list, entries, status_list, &valid);
+
+    for (start = 0; start < valid; start = end) {
+        shard = sorted [start].shard;
+
+        for (end = start; (end < valid) && (sorted [end].shard == shard); end++);
+
+        sai_map_stripe_lock (shard);
+        sai_map_write_begin (shard);
+
+        for (idx = start; idx < end; idx++) {
+            if (value_list == NULL) {
+                sai_map_delete_locked (shard, &key_list [sorted [idx].index],
+                                       sorted [idx].hash);
+            }
+            else {
+                status_list [sorted [idx].index] =
+                    sai_map_delete_elements_locked (shard, &key_list [sorted [idx].index],
+                                                    sorted [idx].hash,
+                                                    &value_list [sorted [idx].index],
+                                                    filter);
+            }
+        }
+
+        sai_map_write_end (shard);
+        sai_map_stripe_unlock (shard);
+    }
+
+    free (entries);
+
+    for (idx = 0; idx < count; idx++) {
+        if (status_list [idx] != SAI_STATUS_SUCCESS) {
+            rc = SAI_STATUS_FAILURE;
+        }
+    }
+
+    return rc;
+}
+
+sai_status_t sai_map_reserve (sai_map_type_t type, uint32_t count)
+{
+    sai_map_shard_t *shard;
+    sai_status_t     rc = SAI_STATUS_SUCCESS;
+    uint32_t         stripe_count;
+    uint32_t         idx;
+
+    if ((uint32_t) type >= SAI_MAP_TYPE_MAX) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (sai_map_oid_relation_type (type)) {
+        return sai_oid_relation_reserve (type, count);
+    }
+
+    /* Keys spread evenly over the stripes, give each a little headroom */
+    stripe_count = ((count + (count / 8)) / SAI_MAP_STRIPES_PER_TYPE) + 1;
+
+    for (idx = 0; (idx < SAI_MAP_STRIPES_PER_TYPE) && (rc == SAI_STATUS_SUCCESS); idx++) {
+        shard = &g_sai_map_shards [type][idx];
+
+        sai_map_stripe_lock (shard);
+
+        if (shard->size < stripe_count) {
+            sai_map_write_begin (shard);
+            rc = sai_map_table_reserve (shard, stripe_count - shard->size);
+            sai_map_write_end (shard);
+        }
+
+        sai_map_stripe_unlock (shard);
+    }
+
+    return rc;
+}
+
+sai_status_t sai_map_get (sai_map_key_t *key, sai_map_val_t *value)
+{
+    sai_map_shard_t *shard;
+    uint64_t     hash = 0;
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    const uint32_t buf_count = value->count;
+
+    return sai_map_read (shard, key, hash, [&] (const sai_map_view_t *view) -> sai_status_t {
+        uint32_t count;
+
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        count = view->count;
+
+        value->count = count;
+
+        if (count > buf_count) {
+            /*
+             * The passed buffer is insufficient. So fill
+             * the count with the actual number of elements,
+             * so that the caller will call with sufficient
+             * memory again.
+             */
+            return SAI_STATUS_BUFFER_OVERFLOW;
+        }
+
+        memcpy (value->data, view->data, count * sizeof (sai_map_data_t));
+
+        return SAI_STATUS_SUCCESS;
+    });
+}
+
+sai_status_t sai_map_get_element_at_index (const sai_map_key_t *key,
+                                           uint32_t index,
+                                           sai_map_val_t *value)
+{
+    sai_map_shard_t *shard;
+    uint64_t     hash = 0;
+
+    if((value == NULL) || (key == NULL)) {
+       return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_map_read (shard, key, hash, [&] (const sai_map_view_t *view) -> sai_status_t {
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        if (index >= view->count) {
+            return SAI_STATUS_INVALID_PARAMETER;
+        }
+
+        value->data[0] = view->data [index];
+
+        return SAI_STATUS_SUCCESS;
+    });
+}
+
+sai_status_t sai_map_get_elements (sai_map_key_t        *key,
+                                   sai_map_val_t        *value,
+                                   sai_map_val_filter_t  filter)
+{
+    sai_map_shard_t *shard;
+    sai_map_data_t  *result;
+    sai_status_t     rc;
+    uint64_t     hash = 0;
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (value->count == 0) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    result = (sai_map_data_t *) calloc (value->count, sizeof (sai_map_data_t));
+    if (result == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    /*
+     * Matches are gathered into a local buffer and only copied to the
+     * caller once the read has validated. The caller's elements are the
+     * match criteria, so a torn read must not overwrite them before a
+     * retry matches on them again.
+     */
+    rc = sai_map_read (shard, key, hash, [&] (const sai_map_view_t *view) -> sai_status_t {
+        sai_map_data_t data;
+        uint32_t       i;
+        uint32_t       position;
+
+        memcpy (result, value->data, value->count * sizeof (sai_map_data_t));
+
+        if (view == NULL) {
+            return SAI_STATUS_SUCCESS;
+        }
+
+        for (i = 0; i < value->count; i++) {
+            position = sai_map_view_find (view, &value->data[i], filter);
+            if (position < view->count) {
+                data = view->data [position];
+                sai_map_copy_value (&result[i], &data, filter);
+            }
+        }
+
+        return SAI_STATUS_SUCCESS;
+    });
+
+    if (rc == SAI_STATUS_SUCCESS) {
+        memcpy (value->data, result, value->count * sizeof (sai_map_data_t));
+    }
+
+    free (result);
+
+    return rc;
+}
+
+bool sai_map_contains (const sai_map_key_t *key, const sai_map_data_t *data,
+                       sai_map_val_filter_t filter)
+{
+    sai_map_shard_t *shard;
+    uint64_t     hash = 0;
+    sai_status_t rc;
+
+    if (data == NULL) {
+        return false;
+    }
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return false;
+    }
+
+    rc = sai_map_read (shard, key, hash, [&] (const sai_map_view_t *view) -> sai_status_t {
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        if (sai_map_view_find (view, data, filter) >= view->count) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        return SAI_STATUS_SUCCESS;
+    });
+
+    return (rc == SAI_STATUS_SUCCESS);
+}
+
+sai_status_t sai_map_get_val_count (sai_map_key_t *key, uint32_t *p_out_count)
+{
+    sai_map_shard_t *shard;
+    uint64_t     hash = 0;
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    return sai_map_read (shard, key, hash, [&] (const sai_map_view_t *view) -> sai_status_t {
+        if (view == NULL) {
+            return SAI_STATUS_ITEM_NOT_FOUND;
+        }
+
+        *p_out_count = view->count;
+
+        return SAI_STATUS_SUCCESS;
+    });
+}
+
+/*
+ * Snapshots the values of 'slot' into 'cursor'. A list is pinned, inline
+ * values are copied into the cursor.
+ */
+static void sai_map_cursor_snapshot (const sai_map_slot_t *slot, sai_map_cursor_t *cursor)
+{
+    sai_map_view_t view;
+
+    sai_map_slot_view (slot, &view);
+
+    cursor->list  = (void *) view.list;
+    cursor->count = view.count;
+
+    if (view.list != NULL) {
+        ((sai_map_list_t *) view.list)->hdr.pins.fetch_add (1);
+    }
+    else {
+        memcpy (cursor->inline_data, view.data, view.count * sizeof (sai_map_data_t));
+    }
+}
+
+sai_status_t sai_map_cursor_open (const sai_map_key_t *key, sai_map_cursor_t *cursor)
+{
+    sai_map_shard_t *shard;
+    sai_map_slot_t  *slot;
+    uint64_t         hash = 0;
+    uint32_t         seq;
+
+    if (cursor == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    shard = sai_map_shard_get (key, &hash);
+    if (shard == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    cursor->list  = NULL;
+    cursor->count = 0;
+    cursor->index = 0;
+
+    if (!sai_epoch_read_lock ()) {
+        sai_map_stripe_lock (shard);
+        slot = sai_map_slot_lookup (shard, key, hash);
+        if (slot != NULL) {
+            sai_map_cursor_snapshot (slot, cursor);
+        }
+        sai_map_stripe_unlock (shard);
+    }
+    else {
+        for (;;) {
+            seq  = sai_map_read_seq_begin (shard);
+            slot = sai_map_shard_find (shard, key, hash);
+
+            if (slot != NULL) {
+                sai_map_cursor_snapshot (slot, cursor);
+            }
+
+            /*
+             * Either the writer sees the pin and copies the list before
+             * changing it, or the pin raced with an update in which case
+             * the sequence check fails and the snapshot is taken again.
+             */
+            std::atomic_thread_fence (std::memory_order_seq_cst);
+
+            if (!sai_map_read_seq_retry (shard, seq)) {
+                break;
+            }
+
+            sai_map_cursor_close (cursor);
+        }
+
+        sai_epoch_read_unlock ();
+    }
+
+    sai_map_stats_lookup (key->type, (slot != NULL));
+
+    if (slot == NULL) {
+        return SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+uint32_t sai_map_cursor_count (const sai_map_cursor_t *cursor)
+{
+    return cursor->count;
+}
+
+const sai_map_data_t *sai_map_cursor_next (sai_map_cursor_t *cursor)
+{
+    const sai_map_list_t *list = (const sai_map_list_t *) cursor->list;
+
+    if (cursor->index >= cursor->count) {
+        return NULL;
+    }
+
+    if (list == NULL) {
+        return &cursor->inline_data [cursor->index++];
+    }
+
+    return &list->data [cursor->index++];
+}
+
+void sai_map_cursor_close (sai_map_cursor_t *cursor)
+{
+    sai_map_list_t *list = (sai_map_list_t *) cursor->list;
+
+    if (list != NULL) {
+        list->hdr.pins.fetch_sub (1, std::memory_order_release);
+        cursor->list = NULL;
+    }
+    cursor->count = 0;
+}
+
+sai_status_t sai_map_foreach (const sai_map_key_t *key, sai_map_visit_fn visit_fn, void *ctx)
+{
+    sai_map_cursor_t      cursor;
+    const sai_map_data_t *data;
+    sai_status_t          rc;
+
+    if (visit_fn == NULL) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    rc = sai_map_cursor_open (key, &cursor);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    while ((data = sai_map_cursor_next (&cursor)) != NULL) {
+        if (!visit_fn (data, ctx)) {
+            break;
+        }
+    }
+
+    sai_map_cursor_close (&cursor);
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_map_get_val1_list (const sai_map_key_t *key, uint32_t *count,
+                                    sai_object_id_t *val1_list)
+{
+    sai_map_cursor_t      cursor;
+    const sai_map_data_t *data;
+    sai_status_t          rc;
+    uint32_t              index = 0;
+
+    if ((count == NULL) || (val1_list == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    rc = sai_map_cursor_open (key, &cursor);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    if (sai_map_cursor_count (&cursor) > *count) {
+        *count = sai_map_cursor_count (&cursor);
+        sai_map_cursor_close (&cursor);
+        return SAI_STATUS_BUFFER_OVERFLOW;
+    }
+
+    while ((data = sai_map_cursor_next (&cursor)) != NULL) {
+        val1_list [index++] = data->val1;
+    }
+
+    sai_map_cursor_close (&cursor);
+    *count = index;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_map_reverse_lookup (sai_map_type_t type, sai_object_id_t val1,
+                                     uint32_t *count, sai_map_key_t *key_list)
+{
+    sai_map_reverse_t *reverse;
+    sai_status_t       rc = SAI_STATUS_SUCCESS;
+    uint32_t           index = 0;
+
+    if ((count == NULL) || (key_list == NULL) || ((uint32_t) type >= SAI_MAP_TYPE_MAX)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    reverse = sai_map_reverse_get (type);
+    if (reverse == NULL) {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    std_mutex_lock (&reverse->mutex);
+
+    auto map_it = reverse->index.find (val1);
+
+    if (map_it == reverse->index.end ()) {
+        rc = SAI_STATUS_ITEM_NOT_FOUND;
+    }
+    else if (map_it->second.size () > *count) {
+        *count = map_it->second.size ();
+        rc = SAI_STATUS_BUFFER_OVERFLOW;
+    }
+    else {
+        for (auto ref_it = map_it->second.begin (); ref_it != map_it->second.end (); ref_it++) {
+            key_list [index++] = ref_it->key;
+        }
+        *count = index;
+    }
+
+    std_mutex_unlock (&reverse->mutex);
+
+    return rc;
+}
+
+sai_status_t sai_map_stats_get (sai_map_type_t type, sai_map_stats_t *stats)
+{
+    const sai_map_type_stats_t *thread_stats;
+    const sai_map_shard_t      *shard;
+    uint64_t                    lock_sampled = 0;
+    uint32_t                    max_values;
+    uint32_t                    idx;
+
+    if (((uint32_t) type >= SAI_MAP_TYPE_MAX) || (stats == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    if (sai_map_oid_relation_type (type)) {
+        return sai_oid_relation_stats_get (type, stats);
+    }
+
+    memset (stats, 0, sizeof (*stats));
+
+    for (idx = 0; idx <= SAI_EPOCH_MAX_READERS; idx++) {
+        thread_stats = &g_sai_map_stats [idx].type [type];
+
+        stats->lookup_hit   += thread_stats->lookup_hit.load (std::memory_order_relaxed);
+        stats->lookup_miss  += thread_stats->lookup_miss.load (std::memory_order_relaxed);
+        stats->lock_count   += thread_stats->lock_count.load (std::memory_order_relaxed);
+        stats->lock_wait_ns += thread_stats->lock_wait_ns.load (std::memory_order_relaxed);
+        stats->lock_hold_ns += thread_stats->lock_hold_ns.load (std::memory_order_relaxed);
+        lock_sampled        += thread_stats->lock_sampled.load (std::memory_order_relaxed);
+    }
+
+    /* Extrapolate the sampled lock times to every acquisition */
+    if (lock_sampled != 0) {
+        stats->lock_wait_ns = (stats->lock_wait_ns / lock_sampled) * stats->lock_count;
+        stats->lock_hold_ns = (stats->lock_hold_ns / lock_sampled) * stats->lock_count;
+    }
+
+    /* Stripe counters are read without the stripe mutex */
+    for (idx = 0; idx < SAI_MAP_STRIPES_PER_TYPE; idx++) {
+        shard = &g_sai_map_shards [type][idx];
+
+        stats->key_count   += shard->stat_keys.load (std::memory_order_relaxed);
+        stats->value_count += shard->stat_values.load (std::memory_order_relaxed);
+        max_values          = shard->stat_max_values.load (std::memory_order_relaxed);
+        if (max_values > stats->max_value_count) {
+            stats->max_value_count = max_values;
+        }
+    }
+
+    return SAI_STATUS_SUCCESS;
+}
+
+static const char *g_sai_map_type_names [] = {
+    "NH_GRP_2_MEMBER_LIST",
+    "NH_MEMBER_2_GRP_INFO",
+    "PORT_TC_AND_COLOR_MAP_LIST",
+    "LAG_RIF_INFO",
+    "BRIDGE_TO_BRIDGE_PORT_LIST",
+    "PORT_VLAN_TO_BRIDGE_PORT_LIST",
+    "LAG_TO_BRIDGE_PORT_LIST",
+    "BRIDGE_PORT_TO_VLAN_MEMBER_LIST",
+    "BRIDGE_PORT_TO_STP_PORT_LIST",
+    "TUNNEL_TO_BRIDGE_PORT_LIST",
+    "TUNNEL_MAP_TO_TUNNEL_LIST",
+    "BRIDGE_PORT_TO_L2MC_MEMBER_LIST",
+    "BRIDGE_TUNNEL_TO_BRIDGE_PORT_LIST",
+    "LAG_PORT_TO_BRIDGE_PORT_LIST",
+    "BRIDGE_PORT_TYPE_TO_BRIDGE_PORT_LIST",
+    "OBJ_TO_REF_COUNT",
+};
+
+static_assert ((sizeof (g_sai_map_type_names) / sizeof (g_sai_map_type_names [0])) ==
+               SAI_MAP_TYPE_MAX, "sai_map type names out of sync with sai_map_type_t");
+
+void sai_map_stats_dump (void)
+{
+    sai_map_stats_t stats;
+    uint32_t        type;
+
+    SAI_DEBUG ("%-32s %10s %10s %8s %12s %12s %12s %12s %12s",
+               "Type", "Keys", "Values", "MaxList", "LookupHit", "LookupMiss",
+               "Locks", "WaitUs", "HoldUs");
+
+    for (type = 0; type < SAI_MAP_TYPE_MAX; type++) {
+        if (sai_map_stats_get ((sai_map_type_t) type, &stats) != SAI_STATUS_SUCCESS) {
+            continue;
+        }
+
+        SAI_DEBUG ("%-32s %10" PRIu64 " %10" PRIu64 " %8u %12" PRIu64 " %12" PRIu64
+                   " %12" PRIu64 " %12" PRIu64 " %12" PRIu64,
+                   g_sai_map_type_names [type], stats.key_count, stats.value_count,
+                   stats.max_value_count, stats.lookup_hit, stats.lookup_miss,
+                   stats.lock_count, stats.lock_wait_ns / 1000, stats.lock_hold_ns / 1000);
+    }
+}
+
+static void sai_map_stats_shell_cmd (std_parsed_string_t)
+{
+    sai_map_stats_dump ();
+}
+
+void sai_map_shell_cmd_init (void)
+{
+    sai_shell_cmd_add ("sai_map_stats", sai_map_stats_shell_cmd,
+                       "Dump sai_map keys, list sizes, lookups and lock times per type");
 }
 }
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2017 Dell Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License. You may obtain
+ * a copy of the License at http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * THIS CODE IS PROVIDED ON AN *AS IS* BASIS, WITHOUT WARRANTIES OR
+ * CONDITIONS OF ANY KIND, EITHER EXPRESS OR IMPLIED, INCLUDING WITHOUT
+ * LIMITATION ANY IMPLIED WARRANTIES OR CONDITIONS OF TITLE, FITNESS
+ * FOR A PARTICULAR PURPOSE, MERCHANTABLITY OR NON-INFRINGEMENT.
+ *
+ * See the Apache Version 2.0 License for specific language governing
+ * permissions and limitations under the License.
+ */
+
+/*
+ * filename: sai_ref_count.cpp
+ */
+
+#include "std_mutex_lock.h"
+#include "sai_ref_count.h"
+#include "sai_map_relation.h"
+#include <atomic>
+#include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * Each referenced object owns a counter in the handle table of this module,
+ * and the index and generation of the counter are cached in the sai_map
+ * under the object id. The counter word holds the generation in its upper
+ * half and the count in its lower half, so a compare-and-swap against a
+ * cached handle fails once the counter has been released and handed to
+ * another object.
+ *
+ * Counts only cross between 0 and 1 with g_sai_ref_count_lock held: the
+ * lock-free paths increment counts that are at least 1 and decrement
+ * counts that are at least 2. The handle table grows in chunks that are
+ * never freed, and released counters are kept on a free list, so a stale
+ * index always resolves to a valid counter.
+ */
+struct sai_ref_count_handle_t {
+    std::atomic<uint64_t>   word;
+
+    /* Index of the next free counter, only used while on the free list */
+    uint32_t                next_free;
+};
+
+#define SAI_REF_COUNT_GEN_SHIFT   (32)
+#define SAI_REF_COUNT_COUNT_MASK  (0xffffffffULL)
+
+#define SAI_REF_COUNT_CHUNK_SHIFT (10)
+#define SAI_REF_COUNT_CHUNK_SIZE  (1 << SAI_REF_COUNT_CHUNK_SHIFT)
+#define SAI_REF_COUNT_MAX_CHUNKS  (1024)
+#define SAI_REF_COUNT_INDEX_NONE  (UINT32_MAX)
+
+static std_mutex_lock_create_static_init_fast (g_sai_ref_count_lock);
+
+/* Chunks of the handle table. Set once with g_sai_ref_count_lock held. */
+static std::atomic<sai_ref_count_handle_t *> g_sai_ref_count_chunks [SAI_REF_COUNT_MAX_CHUNKS];
+
+/* Only accessed with g_sai_ref_count_lock held */
+static uint32_t g_sai_ref_count_num_handles = 0;
+static uint32_t g_sai_ref_count_free_list = SAI_REF_COUNT_INDEX_NONE;
+
+static inline uint32_t sai_ref_count_word_gen (uint64_t word)
+{
+    return (uint32_t) (word >> SAI_REF_COUNT_GEN_SHIFT);
+}
+
+static inline uint32_t sai_ref_count_word_count (uint64_t word)
+{
+    return (uint32_t) (word & SAI_REF_COUNT_COUNT_MASK);
+}
+
+static inline uint64_t sai_ref_count_word (uint32_t gen, uint32_t count)
+{
+    return ((((uint64_t) gen) << SAI_REF_COUNT_GEN_SHIFT) | count);
+}
+
+static sai_ref_count_handle_t *sai_ref_count_handle_at (uint32_t index)
+{
+    uint32_t                chunk_idx = index >> SAI_REF_COUNT_CHUNK_SHIFT;
+    sai_ref_count_handle_t *chunk;
+
+    if (chunk_idx >= SAI_REF_COUNT_MAX_CHUNKS) {
+        return NULL;
+    }
+
+    chunk = g_sai_ref_count_chunks [chunk_idx].load (std::memory_order_acquire);
+
+    return (chunk != NULL) ? &chunk [index & (SAI_REF_COUNT_CHUNK_SIZE - 1)] : NULL;
+}
+
+static bool sai_ref_count_handle_get (sai_object_id_t obj_id, sai_ref_count_handle_t **handle,
+                                      uint32_t *index, uint32_t *gen)
+{
+    sai_map_oid_key_t      key = {obj_id};
+    sai_map_oid_pair_val_t val;
+
+    if (sai_obj_ref_count_relation_t::get (key, &val) != SAI_STATUS_SUCCESS) {
+        return false;
+    }
+
+    *index  = (uint32_t) val.val1;
+    *gen    = (uint32_t) val.val2;
+    *handle = sai_ref_count_handle_at (*index);
+
+    return (*handle != NULL);
+}
+
+/* Must be called with g_sai_ref_count_lock held */
+static sai_status_t sai_ref_count_handle_alloc (uint32_t *index)
+{
+    sai_ref_count_handle_t *chunk;
+    uint32_t                chunk_idx;
+
+    if (g_sai_ref_count_free_list != SAI_REF_COUNT_INDEX_NONE) {
+        *index = g_sai_ref_count_free_list;
+        g_sai_ref_count_free_list = sai_ref_count_handle_at (*index)->next_free;
+        return SAI_STATUS_SUCCESS;
+    }
+
+    chunk_idx = g_sai_ref_count_num_handles >> SAI_REF_COUNT_CHUNK_SHIFT;
+
+    if ((g_sai_ref_count_num_handles & (SAI_REF_COUNT_CHUNK_SIZE - 1)) == 0) {
+        if (chunk_idx >= SAI_REF_COUNT_MAX_CHUNKS) {
+            return SAI_STATUS_INSUFFICIENT_RESOURCES;
+        }
+
+        chunk = (sai_ref_count_handle_t *) calloc (SAI_REF_COUNT_CHUNK_SIZE,
+                                                   sizeof (sai_ref_count_handle_t));
+        if (chunk == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+        g_sai_ref_count_chunks [chunk_idx].store (chunk, std::memory_order_release);
+    }
+
+    *index = g_sai_ref_count_num_handles++;
+
+    return SAI_STATUS_SUCCESS;
+}
+
+/* Must be called with g_sai_ref_count_lock held */
+static void sai_ref_count_handle_free (uint32_t index)
+{
+    sai_ref_count_handle_at (index)->next_free = g_sai_ref_count_free_list;
+    g_sai_ref_count_free_list = index;
+}
+
+/*
+ * Adds one to, or takes one from, the count if the counter still belongs
+ * to generation 'gen' and its count is above 'min_count'.
+ */
+static bool sai_ref_count_try_update (sai_ref_count_handle_t *handle, uint32_t gen,
+                                      bool increment, uint32_t min_count)
+{
+    uint64_t word = handle->word.load (std::memory_order_relaxed);
+    uint64_t new_word;
+
+    do {
+        if ((sai_ref_count_word_gen (word) != gen) ||
+            (sai_ref_count_word_count (word) <= min_count)) {
+            return false;
+        }
+        if (increment && (sai_ref_count_word_count (word) == SAI_REF_COUNT_COUNT_MASK)) {
+            return false;
+        }
+        new_word = increment ? (word + 1) : (word - 1);
+    } while (!handle->word.compare_exchange_weak (word, new_word));
+
+    return true;
+}
+
+/* Must be called with g_sai_ref_count_lock held */
+static sai_status_t sai_ref_count_first_ref_add (sai_object_id_t obj_id)
+{
+    sai_ref_count_handle_t *handle;
+    sai_map_oid_key_t       key = {obj_id};
+    sai_map_oid_pair_val_t  val;
+    uint32_t                index;
+    uint32_t                gen;
+    sai_status_t            rc;
+
+    rc = sai_ref_count_handle_alloc (&index);
+    if (rc != SAI_STATUS_SUCCESS) {
+        return rc;
+    }
+
+    handle = sai_ref_count_handle_at (index);
+
+    gen = sai_ref_count_word_gen (handle->word.load (std::memory_order_relaxed)) + 1;
+    handle->word.store (sai_ref_count_word (gen, 1), std::memory_order_release);
+
+    val.val1 = index;
+    val.val2 = gen;
+
+    rc = sai_obj_ref_count_relation_t::insert (key, val);
+    if (rc != SAI_STATUS_SUCCESS) {
+        handle->word.store (sai_ref_count_word (gen, 0), std::memory_order_release);
+        sai_ref_count_handle_free (index);
+    }
+
+    return rc;
+}
+
+/* Must be called with g_sai_ref_count_lock held */
+static void sai_ref_count_last_ref_release (sai_object_id_t obj_id, uint32_t index)
+{
+    sai_map_oid_key_t key = {obj_id};
+
+    sai_obj_ref_count_relation_t::erase (key);
+
+    sai_ref_count_handle_free (index);
+}
+
+extern "C" {
+
+sai_status_t sai_ref_count_increment (sai_object_id_t            obj_id,
+                                      sai_ref_count_obj_check_fn obj_check_fn)
+{
+    sai_ref_count_handle_t *handle;
+    uint32_t                index;
+    uint32_t                gen;
+    sai_status_t            rc = SAI_STATUS_SUCCESS;
+
+    if (sai_ref_count_handle_get (obj_id, &handle, &index, &gen) &&
+        sai_ref_count_try_update (handle, gen, true, 0)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    std_mutex_lock (&g_sai_ref_count_lock);
+
+    if (sai_ref_count_handle_get (obj_id, &handle, &index, &gen)) {
+        if (!sai_ref_count_try_update (handle, gen, true, 0)) {
+            rc = SAI_STATUS_FAILURE;
+        }
+    }
+    else if ((obj_check_fn != NULL) && !obj_check_fn (obj_id)) {
+        rc = SAI_STATUS_ITEM_NOT_FOUND;
+    }
+    else {
+        rc = sai_ref_count_first_ref_add (obj_id);
+    }
+
+    std_mutex_unlock (&g_sai_ref_count_lock);
+
+    return rc;
+}
+
+sai_status_t sai_ref_count_decrement (sai_object_id_t obj_id)
+{
+    sai_ref_count_handle_t *handle;
+    uint32_t                index;
+    uint32_t                gen;
+    uint64_t                word;
+    bool                    released = false;
+    sai_status_t            rc = SAI_STATUS_SUCCESS;
+
+    if (sai_ref_count_handle_get (obj_id, &handle, &index, &gen) &&
+        sai_ref_count_try_update (handle, gen, false, 1)) {
+        return SAI_STATUS_SUCCESS;
+    }
+
+    std_mutex_lock (&g_sai_ref_count_lock);
+
+    if (!sai_ref_count_handle_get (obj_id, &handle, &index, &gen)) {
+        rc = SAI_STATUS_ITEM_NOT_FOUND;
+    }
+    else {
+        /* Lock-free increments may still move the count off 1 */
+        while (!sai_ref_count_try_update (handle, gen, false, 1)) {
+            word = sai_ref_count_word (gen, 1);
+            if (handle->word.compare_exchange_strong (word, sai_ref_count_word (gen, 0))) {
+                released = true;
+                break;
+            }
+        }
+
+        if (released) {
+            sai_ref_count_last_ref_release (obj_id, index);
+        }
+    }
+
+    std_mutex_unlock (&g_sai_ref_count_lock);
+
+    return rc;
+}
+
+uint_t sai_ref_count_get (sai_object_id_t obj_id)
+{
+    sai_ref_count_handle_t *handle;
+    uint32_t                index;
+    uint32_t                gen;
+    uint64_t                word;
+
+    if (!sai_ref_count_handle_get (obj_id, &handle, &index, &gen)) {
+        return 0;
+    }
+
+    word = handle->word.load (std::memory_order_acquire);
+
+    return (sai_ref_count_word_gen (word) == gen) ? sai_ref_count_word_count (word) : 0;
+}
+
+bool sai_ref_count_is_in_use (sai_object_id_t obj_id)
+{
+    return (sai_ref_count_get (obj_id) > 0);
+}
+
+}
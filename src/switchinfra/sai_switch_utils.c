@@ -37,6 +37,7 @@
 #include "sai_oid_utils.h"
 #include "sai_l3_util.h"
 #include "sai_infra_api.h"
+#include "sai_map_utl.h"
 
 
 /*
@@ -145,6 +146,14 @@ void sai_switch_info_initialize(const sai_switch_init_config_t *switch_info)
     sai_switch_info_ptr->lag_hash_algo = SAI_HASH_ALGORITHM_CRC;
     sai_switch_info_ptr->ecmp_hash_seed = 0;
     sai_switch_info_ptr->lag_hash_seed = 0;
+
+    /* Every logical port gets a bridge port, size its maps once at init */
+    sai_map_reserve (SAI_MAP_TYPE_BRIDGE_PORT_TO_VLAN_MEMBER_LIST,
+                     switch_info->max_logical_ports);
+    sai_map_reserve (SAI_MAP_TYPE_BRIDGE_PORT_TO_STP_PORT_LIST,
+                     switch_info->max_logical_ports);
+
+    sai_map_shell_cmd_init ();
 }
 
 sai_switch_id_t sai_switch_id_get(void)
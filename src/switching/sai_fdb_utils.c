@@ -24,12 +24,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include <inttypes.h>
+#include <time.h>
+#include <limits.h>
 #include "std_assert.h"
 #include "saifdb.h"
 #include "saitypes.h"
 #include "saiswitch.h"
 #include "saistatus.h"
 #include "std_radix.h"
+#include "std_llist.h"
+#include "std_rbtree.h"
 #include "sai_fdb_api.h"
 #include "sai_fdb_common.h"
 #include "std_mutex_lock.h"
@@ -39,62 +43,702 @@
 #include "sai_oid_utils.h"
 #include "sai_lag_api.h"
 #include "sai_npu_fdb.h"
+#include "sai_hash_group.h"
 
+#define SAI_FDB_HASH_INIT_GROUP_COUNT    (64)
+
+#define SAI_FDB_FILTER_BLOCK_SIZE        (64)
+#define SAI_FDB_FILTER_BLOCK_COUNT       (SAI_FDB_REGISTERED_FILTER_SIZE / SAI_FDB_FILTER_BLOCK_SIZE)
+#define SAI_FDB_FILTER_HASH_COUNT        (3)
+#define SAI_FDB_FILTER_COUNTER_MAX       (255)
+
+#define SAI_FDB_LEARN_STATE(_count, _limit)  (((uint64_t)(_limit) << 32) | (uint64_t)(_count))
+#define SAI_FDB_LEARN_STATE_COUNT(_state)    ((uint_t)((_state) & 0xffffffff))
+#define SAI_FDB_LEARN_STATE_LIMIT(_state)    ((uint_t)((_state) >> 32))
+
+#define SAI_FDB_NODE_FROM_PORT_LINK(_link) \
+    ((sai_fdb_entry_node_t *)((char *)(_link) - STD_STR_OFFSET_OF(sai_fdb_entry_node_t, port_link)))
+#define SAI_FDB_REGISTERED_NODE_FROM_DAMPENED_LINK(_link) \
+    ((sai_fdb_registered_node_t *)((char *)(_link) - \
+                                   STD_STR_OFFSET_OF(sai_fdb_registered_node_t, dampened_link)))
+#define SAI_FDB_NODE_FROM_VLAN_LINK(_link) \
+    ((sai_fdb_entry_node_t *)((char *)(_link) - STD_STR_OFFSET_OF(sai_fdb_entry_node_t, vlan_link)))
 
 static sai_fdb_global_data_t sai_fdb_global_cache;
-static std_mutex_lock_create_static_init_fast(fdb_lock);
+static std_mutex_lock_create_static_init_fast(fdb_port_learn_lock);
 static sai_fdb_internal_callback_fn fdb_internal_callback = NULL;
 static sai_npu_flush_fdb_entry_fn sai_npu_flush_fdb_entry = NULL;
+static sai_fdb_learn_limit_callback_fn fdb_learn_limit_callback = NULL;
+
+/*
+ * FDB shards
+ * ----------
+ * The FDB key starts with the VLAN, so the entries, registered entries and
+ * notifications of a VLAN all live in one shard, with its own lock. Learn,
+ * age and notifications in different VLANs only contend when their VLANs
+ * hash to the same shard. Consecutive VLANs go to different shards.
+ */
+static inline uint_t sai_fdb_shard_idx_get(sai_vlan_id_t vlan_id)
+{
+    return (vlan_id & (SAI_FDB_NUM_SHARDS - 1));
+}
+
+static inline sai_fdb_shard_t *sai_fdb_shard_get(sai_vlan_id_t vlan_id)
+{
+    return &sai_fdb_global_cache.shards[sai_fdb_shard_idx_get(vlan_id)];
+}
+
+/*
+ * FDB exact match index
+ * ---------------------
+ * Learn, age and lookup only ever need the node of one (vlan, MAC) key, so
+ * they go through an open addressing index keyed on the packed 64 bit key
+ * instead of walking the radix tree. The radix tree is kept for the ordered
+ * walks of sai_get_next_fdb_entry_node. Both are updated together under
+ * the lock of the shard. The index probes its slots with the same group
+ * primitives as the SAI map tables, from sai_hash_group.h.
+ */
+static inline uint64_t sai_fdb_key_pack(const sai_fdb_entry_key_t *fdb_key)
+{
+    uint64_t key = 0;
+
+    memcpy(&key, fdb_key, sizeof(*fdb_key));
+    return key;
+}
+
+static inline uint64_t sai_fdb_key_hash(uint64_t key)
+{
+    return sai_hash_mix64(key);
+}
+
+static sai_fdb_hash_slot_t *sai_fdb_hash_slot_find(const sai_fdb_hash_index_t *index,
+                                                   uint64_t key)
+{
+    uint64_t      hash = sai_fdb_key_hash(key);
+    const int8_t *group;
+    uint_t        group_idx;
+    uint_t        probe;
+    uint_t        slot_idx;
+    uint32_t      match;
+
+    if(index->ctrl == NULL) {
+        return NULL;
+    }
+
+    SAI_HASH_FOR_EACH_PROBE_GROUP(index->group_count, hash, group_idx, probe) {
+        group = &index->ctrl[group_idx * SAI_HASH_GROUP_SIZE];
+
+        for (match = sai_hash_group_match(group, sai_hash_h2(hash));
+             match != 0; match &= (match - 1)) {
+            slot_idx = (group_idx * SAI_HASH_GROUP_SIZE) + __builtin_ctz(match);
+            if(index->slots[slot_idx].key == key) {
+                return &index->slots[slot_idx];
+            }
+        }
+
+        if(sai_hash_group_match(group, SAI_HASH_CTRL_EMPTY) != 0) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+/* Places a key known not to be in the index. The index must have a free slot. */
+static void sai_fdb_hash_slot_place(sai_fdb_hash_index_t *index, uint64_t key,
+                                    sai_fdb_entry_node_t *fdb_entry_node)
+{
+    uint64_t hash = sai_fdb_key_hash(key);
+    uint_t   group_idx;
+    uint_t   probe;
+    uint_t   slot_idx;
+    uint32_t match;
+
+    SAI_HASH_FOR_EACH_PROBE_GROUP(index->group_count, hash, group_idx, probe) {
+        match = sai_hash_group_match_free(&index->ctrl[group_idx * SAI_HASH_GROUP_SIZE]);
+        if(match == 0) {
+            continue;
+        }
+        slot_idx = (group_idx * SAI_HASH_GROUP_SIZE) + __builtin_ctz(match);
+        if(index->ctrl[slot_idx] == SAI_HASH_CTRL_DELETED) {
+            index->deleted--;
+        }
+        index->ctrl[slot_idx] = sai_hash_h2(hash);
+        index->slots[slot_idx].key = key;
+        index->slots[slot_idx].fdb_entry_node = fdb_entry_node;
+        index->used++;
+        return;
+    }
+    STD_ASSERT(0);
+}
+
+static sai_status_t sai_fdb_hash_index_resize(sai_fdb_hash_index_t *index, uint_t group_count)
+{
+    sai_fdb_hash_index_t new_index;
+    uint_t               slot_idx;
+
+    memset(&new_index, 0, sizeof(new_index));
+    new_index.group_count = group_count;
+    new_index.ctrl = (int8_t *)malloc(group_count * SAI_HASH_GROUP_SIZE);
+    new_index.slots = (sai_fdb_hash_slot_t *)calloc(group_count * SAI_HASH_GROUP_SIZE,
+                                                    sizeof(sai_fdb_hash_slot_t));
+    if((new_index.ctrl == NULL) || (new_index.slots == NULL)) {
+        SAI_FDB_LOG_CRIT("No memory for FDB hash index of %d groups", group_count);
+        free(new_index.ctrl);
+        free(new_index.slots);
+        return SAI_STATUS_NO_MEMORY;
+    }
+    memset(new_index.ctrl, SAI_HASH_CTRL_EMPTY, group_count * SAI_HASH_GROUP_SIZE);
+
+    if(index->ctrl != NULL) {
+        for (slot_idx = 0; slot_idx < (index->group_count * SAI_HASH_GROUP_SIZE);
+             slot_idx++) {
+            if(index->ctrl[slot_idx] >= 0) {
+                sai_fdb_hash_slot_place(&new_index, index->slots[slot_idx].key,
+                                        index->slots[slot_idx].fdb_entry_node);
+            }
+        }
+    }
+    free(index->ctrl);
+    free(index->slots);
+    *index = new_index;
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_status_t sai_fdb_hash_index_insert(sai_fdb_hash_index_t *index,
+                                              sai_fdb_entry_node_t *fdb_entry_node)
+{
+    uint_t       slot_count = index->group_count * SAI_HASH_GROUP_SIZE;
+    uint_t       group_count = index->group_count;
+    sai_status_t sai_rc;
+
+    /* Keep the load, deleted markers included, under 7/8 */
+    if(((index->used + index->deleted + 1) * 8) > (slot_count * 7)) {
+        if(((index->used + 1) * 2) > slot_count) {
+            group_count *= 2;
+        }
+        sai_rc = sai_fdb_hash_index_resize(index, group_count);
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+    }
+    sai_fdb_hash_slot_place(index, sai_fdb_key_pack(&fdb_entry_node->fdb_key), fdb_entry_node);
+    return SAI_STATUS_SUCCESS;
+}
 
+/* Grows the index once so that 'count' more keys fit without resizing */
+static sai_status_t sai_fdb_hash_index_reserve(sai_fdb_hash_index_t *index, uint_t count)
+{
+    uint_t group_count = index->group_count;
+
+    if(((index->used + index->deleted + count) * 8) <=
+       (group_count * SAI_HASH_GROUP_SIZE * 7)) {
+        return SAI_STATUS_SUCCESS;
+    }
+    while (((index->used + count) * 2) > (group_count * SAI_HASH_GROUP_SIZE)) {
+        group_count *= 2;
+    }
+    return sai_fdb_hash_index_resize(index, group_count);
+}
+
+static void sai_fdb_hash_index_remove(sai_fdb_hash_index_t *index,
+                                      sai_fdb_entry_node_t *fdb_entry_node)
+{
+    sai_fdb_hash_slot_t *slot;
+    uint_t               slot_idx;
+    uint_t               group_idx;
+
+    slot = sai_fdb_hash_slot_find(index, sai_fdb_key_pack(&fdb_entry_node->fdb_key));
+    if((slot == NULL) || (slot->fdb_entry_node != fdb_entry_node)) {
+        return;
+    }
+    slot_idx = (uint_t)(slot - index->slots);
+    group_idx = slot_idx / SAI_HASH_GROUP_SIZE;
+
+    /* A group that still has an empty slot never ended a probe, so the slot can be emptied */
+    if(sai_hash_group_match(&index->ctrl[group_idx * SAI_HASH_GROUP_SIZE],
+                            SAI_HASH_CTRL_EMPTY) != 0) {
+        index->ctrl[slot_idx] = SAI_HASH_CTRL_EMPTY;
+    } else {
+        index->ctrl[slot_idx] = SAI_HASH_CTRL_DELETED;
+        index->deleted++;
+    }
+    slot->fdb_entry_node = NULL;
+    index->used--;
+}
+
+/*
+ * Registered entry filter
+ * -----------------------
+ * Only a few entries are registered compared to the learnt ones, so a
+ * counting bloom filter of the registered keys lets most learn and age
+ * events skip the registered tree lookup. All the counters of a key are in
+ * one cache line. Counters that saturate are never decremented.
+ */
+static inline uint8_t *sai_fdb_registered_filter_block(sai_fdb_shard_t *shard, uint64_t hash)
+{
+    return &shard->registered_filter[((hash >> 32) & (SAI_FDB_FILTER_BLOCK_COUNT - 1)) *
+                                     SAI_FDB_FILTER_BLOCK_SIZE];
+}
+
+static inline uint_t sai_fdb_registered_filter_pos(uint64_t hash, uint_t hash_idx)
+{
+    return (uint_t)(hash >> (hash_idx * 6)) & (SAI_FDB_FILTER_BLOCK_SIZE - 1);
+}
+
+static void sai_fdb_registered_filter_update(sai_fdb_shard_t *shard,
+                                             const sai_fdb_entry_key_t *fdb_key, bool add)
+{
+    uint64_t hash = sai_fdb_key_hash(sai_fdb_key_pack(fdb_key));
+    uint8_t *block = sai_fdb_registered_filter_block(shard, hash);
+    uint8_t *counter = NULL;
+    uint_t hash_idx;
+
+    for (hash_idx = 0; hash_idx < SAI_FDB_FILTER_HASH_COUNT; hash_idx++) {
+        counter = &block[sai_fdb_registered_filter_pos(hash, hash_idx)];
+        if(*counter == SAI_FDB_FILTER_COUNTER_MAX) {
+            continue;
+        }
+        if(add) {
+            (*counter)++;
+        } else if(*counter > 0) {
+            (*counter)--;
+        }
+    }
+}
+
+static bool sai_fdb_registered_filter_may_contain(sai_fdb_shard_t *shard,
+                                                  const sai_fdb_entry_key_t *fdb_key)
+{
+    uint64_t hash = sai_fdb_key_hash(sai_fdb_key_pack(fdb_key));
+    const uint8_t *block = sai_fdb_registered_filter_block(shard, hash);
+    uint_t hash_idx;
+
+    for (hash_idx = 0; hash_idx < SAI_FDB_FILTER_HASH_COUNT; hash_idx++) {
+        if(block[sai_fdb_registered_filter_pos(hash, hash_idx)] == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*
+ * FDB entry nodes are carved out of chunks and recycled through a free
+ * list of the shard, so that a learn burst allocates once. Chunks are never
+ * returned.
+ */
+static inline sai_fdb_entry_node_t **sai_fdb_free_node_next(sai_fdb_entry_node_t *fdb_entry_node)
+{
+    return (sai_fdb_entry_node_t **)fdb_entry_node;
+}
+
+/* Makes sure at least 'count' free nodes are available */
+static sai_status_t sai_fdb_node_pool_reserve(sai_fdb_shard_t *shard, uint_t count)
+{
+    sai_fdb_entry_node_t *chunk = NULL;
+    uint_t chunk_count;
+    uint_t node_idx;
+
+    if(shard->num_free_nodes >= count) {
+        return SAI_STATUS_SUCCESS;
+    }
+    chunk_count = count - shard->num_free_nodes;
+    if(chunk_count < SAI_FDB_NODE_POOL_CHUNK) {
+        chunk_count = SAI_FDB_NODE_POOL_CHUNK;
+    }
+    chunk = (sai_fdb_entry_node_t *)calloc(chunk_count, sizeof(sai_fdb_entry_node_t));
+    if(chunk == NULL) {
+        SAI_FDB_LOG_CRIT("No memory for %d FDB entry nodes", chunk_count);
+        return SAI_STATUS_NO_MEMORY;
+    }
+    for (node_idx = 0; node_idx < chunk_count; node_idx++) {
+        *sai_fdb_free_node_next(&chunk[node_idx]) = shard->free_nodes;
+        shard->free_nodes = &chunk[node_idx];
+    }
+    shard->num_free_nodes += chunk_count;
+    return SAI_STATUS_SUCCESS;
+}
+
+static sai_fdb_entry_node_t *sai_fdb_entry_node_alloc(sai_fdb_shard_t *shard)
+{
+    sai_fdb_entry_node_t *fdb_entry_node = NULL;
+
+    if(sai_fdb_node_pool_reserve(shard, 1) != SAI_STATUS_SUCCESS) {
+        return NULL;
+    }
+    fdb_entry_node = shard->free_nodes;
+    shard->free_nodes = *sai_fdb_free_node_next(fdb_entry_node);
+    shard->num_free_nodes--;
+    memset(fdb_entry_node, 0, sizeof(sai_fdb_entry_node_t));
+    return fdb_entry_node;
+}
+
+static void sai_fdb_entry_node_free(sai_fdb_shard_t *shard,
+                                    sai_fdb_entry_node_t *fdb_entry_node)
+{
+    *sai_fdb_free_node_next(fdb_entry_node) = shard->free_nodes;
+    shard->free_nodes = fdb_entry_node;
+    shard->num_free_nodes++;
+}
+
+/*
+ * Every FDB entry node is linked to the list of its port node and to the
+ * list of its VLAN node, so that flushes by port and/or VLAN only visit
+ * the entries they may remove. Port nodes belong to a shard, and are
+ * created on the first entry of the shard learnt on a port and freed with
+ * the last one.
+ */
+static sai_fdb_port_node_t *sai_fdb_port_node_get(sai_fdb_shard_t *shard,
+                                                  sai_object_id_t port_id)
+{
+    sai_fdb_port_node_t port_node;
+
+    memset(&port_node, 0, sizeof(port_node));
+    port_node.port_id = port_id;
+    return (sai_fdb_port_node_t *)std_rbtree_getexact(shard->fdb_port_tree, &port_node);
+}
+
+/*
+ * Dynamic entries on a port are counted on the learn node of the port,
+ * shared by its port nodes in all shards and kept while it has a learn
+ * limit. The learn tree is protected by fdb_port_learn_lock, while the
+ * count and limit of a learn node are updated together atomically, so that
+ * shards count without taking that lock and every crossing of the limit is
+ * reported once.
+ */
+static sai_fdb_port_learn_node_t *sai_fdb_port_learn_node_get(sai_object_id_t port_id)
+{
+    sai_fdb_port_learn_node_t learn_node;
+
+    memset(&learn_node, 0, sizeof(learn_node));
+    learn_node.port_id = port_id;
+    return (sai_fdb_port_learn_node_t *)std_rbtree_getexact(
+                                            sai_fdb_global_cache.fdb_port_learn_tree,
+                                            &learn_node);
+}
+
+static sai_fdb_port_learn_node_t *sai_fdb_port_learn_node_get_or_create(sai_object_id_t port_id)
+{
+    sai_fdb_port_learn_node_t *learn_node = sai_fdb_port_learn_node_get(port_id);
+
+    if(learn_node != NULL) {
+        return learn_node;
+    }
+    learn_node = (sai_fdb_port_learn_node_t *)calloc(1, sizeof(sai_fdb_port_learn_node_t));
+    if(learn_node == NULL) {
+        SAI_FDB_LOG_CRIT("No memory for %d", sizeof(sai_fdb_port_learn_node_t));
+        return NULL;
+    }
+    learn_node->port_id = port_id;
+    if(std_rbtree_insert(sai_fdb_global_cache.fdb_port_learn_tree,
+                         learn_node) != STD_ERR_OK) {
+        SAI_FDB_LOG_ERR("Unable to add FDB port learn node 0x%"PRIx64"", port_id);
+        free(learn_node);
+        return NULL;
+    }
+    return learn_node;
+}
+
+/* Frees the learn node once no port node refers to it and it has no limit */
+static void sai_fdb_port_learn_node_release(sai_fdb_port_learn_node_t *learn_node)
+{
+    uint64_t learn_state = __atomic_load_n(&learn_node->learn_state, __ATOMIC_RELAXED);
+
+    if((learn_node->ref_count == 0) &&
+       (SAI_FDB_LEARN_STATE_LIMIT(learn_state) == SAI_FDB_LEARN_LIMIT_DISABLE)) {
+        std_rbtree_remove(sai_fdb_global_cache.fdb_port_learn_tree, learn_node);
+        free(learn_node);
+    }
+}
+
+static sai_fdb_port_node_t *sai_fdb_port_node_get_or_create(sai_fdb_shard_t *shard,
+                                                            sai_object_id_t port_id)
+{
+    sai_fdb_port_node_t *port_node = sai_fdb_port_node_get(shard, port_id);
+
+    if(port_node != NULL) {
+        return port_node;
+    }
+    port_node = (sai_fdb_port_node_t *)calloc(1, sizeof(sai_fdb_port_node_t));
+    if(port_node == NULL) {
+        SAI_FDB_LOG_CRIT("No memory for %d", sizeof(sai_fdb_port_node_t));
+        return NULL;
+    }
+    port_node->port_id = port_id;
+    std_dll_init(&port_node->fdb_list);
+
+    std_mutex_lock(&fdb_port_learn_lock);
+    port_node->learn_node = sai_fdb_port_learn_node_get_or_create(port_id);
+    if(port_node->learn_node != NULL) {
+        port_node->learn_node->ref_count++;
+    }
+    std_mutex_unlock(&fdb_port_learn_lock);
+    if(port_node->learn_node == NULL) {
+        free(port_node);
+        return NULL;
+    }
+
+    if(std_rbtree_insert(shard->fdb_port_tree, port_node) != STD_ERR_OK) {
+        SAI_FDB_LOG_ERR("Unable to add FDB port node 0x%"PRIx64"", port_id);
+        std_mutex_lock(&fdb_port_learn_lock);
+        port_node->learn_node->ref_count--;
+        sai_fdb_port_learn_node_release(port_node->learn_node);
+        std_mutex_unlock(&fdb_port_learn_lock);
+        free(port_node);
+        return NULL;
+    }
+    return port_node;
+}
+
+static void sai_fdb_entry_port_unlink(sai_fdb_entry_node_t *fdb_entry_node)
+{
+    sai_fdb_port_node_t *port_node = fdb_entry_node->port_node;
+    sai_fdb_shard_t *shard = NULL;
+
+    if(port_node == NULL) {
+        return;
+    }
+    std_dll_remove(&port_node->fdb_list, &fdb_entry_node->port_link);
+    port_node->fdb_count--;
+    fdb_entry_node->port_node = NULL;
+    if(port_node->fdb_count == 0) {
+        shard = sai_fdb_shard_get(fdb_entry_node->fdb_key.vlan_id);
+        std_rbtree_remove(shard->fdb_port_tree, port_node);
+        std_mutex_lock(&fdb_port_learn_lock);
+        port_node->learn_node->ref_count--;
+        sai_fdb_port_learn_node_release(port_node->learn_node);
+        std_mutex_unlock(&fdb_port_learn_lock);
+        free(port_node);
+    }
+}
+
+/* Sets the port of the entry, moving it to the list of the port node */
+static sai_status_t sai_fdb_entry_port_link(sai_fdb_entry_node_t *fdb_entry_node,
+                                            sai_object_id_t port_id)
+{
+    sai_fdb_port_node_t *port_node = NULL;
+
+    if((fdb_entry_node->port_node == NULL) ||
+       (fdb_entry_node->port_node->port_id != port_id)) {
+        port_node = sai_fdb_port_node_get_or_create(
+                                    sai_fdb_shard_get(fdb_entry_node->fdb_key.vlan_id),
+                                    port_id);
+        if(port_node == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+        sai_fdb_entry_port_unlink(fdb_entry_node);
+        std_dll_insertatback(&port_node->fdb_list, &fdb_entry_node->port_link);
+        port_node->fdb_count++;
+        fdb_entry_node->port_node = port_node;
+    }
+    fdb_entry_node->port_id = port_id;
+    return SAI_STATUS_SUCCESS;
+}
+
+static void sai_fdb_entry_vlan_link(sai_fdb_entry_node_t *fdb_entry_node)
+{
+    sai_fdb_vlan_node_t *vlan_node =
+        &sai_fdb_global_cache.fdb_vlan_nodes[fdb_entry_node->fdb_key.vlan_id];
+
+    std_dll_insertatback(&vlan_node->fdb_list, &fdb_entry_node->vlan_link);
+    vlan_node->fdb_count++;
+}
+
+static void sai_fdb_entry_vlan_unlink(sai_fdb_entry_node_t *fdb_entry_node)
+{
+    sai_fdb_vlan_node_t *vlan_node =
+        &sai_fdb_global_cache.fdb_vlan_nodes[fdb_entry_node->fdb_key.vlan_id];
+
+    std_dll_remove(&vlan_node->fdb_list, &fdb_entry_node->vlan_link);
+    vlan_node->fdb_count--;
+}
+
+/*
+ * Dynamic entries are counted on their port learn node and VLAN node.
+ * Changes of the port or type of a counted entry are made between taking it
+ * out of the counts and putting it back in.
+ */
+static inline bool sai_fdb_learn_limit_exceeded(uint_t learn_count, uint_t learn_limit)
+{
+    return ((learn_limit != SAI_FDB_LEARN_LIMIT_DISABLE) && (learn_count > learn_limit));
+}
+
+/* Reports a change of count or limit that crosses the limit */
+static void sai_fdb_learn_limit_notify(sai_object_id_t port_id, sai_vlan_id_t vlan_id,
+                                       uint_t old_count, uint_t old_limit,
+                                       uint_t new_count, uint_t new_limit)
+{
+    bool was_exceeded = sai_fdb_learn_limit_exceeded(old_count, old_limit);
+
+    if((fdb_learn_limit_callback != NULL) &&
+       (was_exceeded != sai_fdb_learn_limit_exceeded(new_count, new_limit))) {
+        fdb_learn_limit_callback(port_id, vlan_id, new_count, !was_exceeded);
+    }
+}
+
+static void sai_fdb_port_learn_count_update(sai_fdb_port_learn_node_t *learn_node, bool add)
+{
+    uint64_t old_state = __atomic_load_n(&learn_node->learn_state, __ATOMIC_RELAXED);
+    uint64_t new_state;
+
+    do {
+        new_state = SAI_FDB_LEARN_STATE(SAI_FDB_LEARN_STATE_COUNT(old_state) + (add ? 1 : -1),
+                                        SAI_FDB_LEARN_STATE_LIMIT(old_state));
+    } while (!__atomic_compare_exchange_n(&learn_node->learn_state, &old_state, new_state,
+                                          true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+    sai_fdb_learn_limit_notify(learn_node->port_id, VLAN_UNDEF,
+                               SAI_FDB_LEARN_STATE_COUNT(old_state),
+                               SAI_FDB_LEARN_STATE_LIMIT(old_state),
+                               SAI_FDB_LEARN_STATE_COUNT(new_state),
+                               SAI_FDB_LEARN_STATE_LIMIT(new_state));
+}
+
+static void sai_fdb_vlan_learn_count_update(sai_vlan_id_t vlan_id, bool add)
+{
+    sai_fdb_vlan_node_t *vlan_node = &sai_fdb_global_cache.fdb_vlan_nodes[vlan_id];
+    uint_t old_count = vlan_node->learn_count;
+
+    if(add) {
+        vlan_node->learn_count++;
+    } else {
+        vlan_node->learn_count--;
+    }
+    sai_fdb_learn_limit_notify(SAI_NULL_OBJECT_ID, vlan_id, old_count, vlan_node->learn_limit,
+                               vlan_node->learn_count, vlan_node->learn_limit);
+}
+
+static void sai_fdb_entry_learn_count_update(sai_fdb_entry_node_t *fdb_entry_node, bool add)
+{
+    if(fdb_entry_node->entry_type != SAI_FDB_ENTRY_TYPE_DYNAMIC) {
+        return;
+    }
+    if(fdb_entry_node->port_node != NULL) {
+        sai_fdb_port_learn_count_update(fdb_entry_node->port_node->learn_node, add);
+    }
+    sai_fdb_vlan_learn_count_update(fdb_entry_node->fdb_key.vlan_id, add);
+}
+
+/* Takes the node out of the tree, the index and the port and VLAN lists */
+static void sai_fdb_entry_node_unlink(sai_fdb_entry_node_t *fdb_entry_node)
+{
+    sai_fdb_shard_t *shard = sai_fdb_shard_get(fdb_entry_node->fdb_key.vlan_id);
+
+    sai_fdb_entry_port_unlink(fdb_entry_node);
+    sai_fdb_entry_vlan_unlink(fdb_entry_node);
+    sai_fdb_hash_index_remove(&shard->fdb_hash_index, fdb_entry_node);
+    std_radix_remove(shard->sai_global_fdb_tree, &(fdb_entry_node->fdb_rt_head));
+}
+
+/* Shards are always locked in index order, so that locking all of them cannot deadlock */
 void sai_fdb_lock(void)
 {
-    std_mutex_lock(&fdb_lock);
+    uint_t shard_idx;
+
+    for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+        std_mutex_lock(&sai_fdb_global_cache.shards[shard_idx].lock);
+    }
 }
 
 void sai_fdb_unlock(void)
 {
-    std_mutex_unlock(&fdb_lock);
+    uint_t shard_idx;
+
+    for (shard_idx = SAI_FDB_NUM_SHARDS; shard_idx > 0; shard_idx--) {
+        std_mutex_unlock(&sai_fdb_global_cache.shards[shard_idx - 1].lock);
+    }
+}
+
+void sai_fdb_shard_lock(sai_vlan_id_t vlan_id)
+{
+    std_mutex_lock(&sai_fdb_shard_get(vlan_id)->lock);
 }
 
-sai_status_t sai_init_fdb_tree(void)
+void sai_fdb_shard_unlock(sai_vlan_id_t vlan_id)
 {
-    SAI_FDB_LOG_TRACE("Performing FDB Module Init");
-    sai_fdb_global_cache.sai_global_fdb_tree = std_radix_create("FDBTree", SAI_FDB_ENTRY_KEY_SIZE,
-                                           NULL, NULL, 0);
-    if(sai_fdb_global_cache.sai_global_fdb_tree == NULL) {
+    std_mutex_unlock(&sai_fdb_shard_get(vlan_id)->lock);
+}
+
+static sai_status_t sai_fdb_shard_init(sai_fdb_shard_t *shard)
+{
+    if(std_mutex_lock_init_non_recursive(&shard->lock) != STD_ERR_OK) {
+        SAI_FDB_LOG_CRIT("Unable to perform FDB shard lock Init");
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    shard->sai_global_fdb_tree = std_radix_create("FDBTree", SAI_FDB_ENTRY_KEY_SIZE,
+                                                  NULL, NULL, 0);
+    if(shard->sai_global_fdb_tree == NULL) {
         SAI_FDB_LOG_CRIT("Unable to perform FDB Cache Init");
         return SAI_STATUS_UNINITIALIZED;
     }
 
-    sai_fdb_global_cache.sai_registered_fdb_entry_tree = std_radix_create("FDBNotificationTree",
-                                                        SAI_FDB_ENTRY_KEY_SIZE,
-                                                        NULL, NULL, 0);
+    if(sai_fdb_hash_index_resize(&shard->fdb_hash_index,
+                                 SAI_FDB_HASH_INIT_GROUP_COUNT) != SAI_STATUS_SUCCESS) {
+        SAI_FDB_LOG_CRIT("Unable to perform FDB hash index Init");
+        return SAI_STATUS_UNINITIALIZED;
+    }
+
+    shard->sai_registered_fdb_entry_tree = std_radix_create("FDBNotificationTree",
+                                                            SAI_FDB_ENTRY_KEY_SIZE,
+                                                            NULL, NULL, 0);
 
-    if(sai_fdb_global_cache.sai_registered_fdb_entry_tree == NULL) {
+    if(shard->sai_registered_fdb_entry_tree == NULL) {
         SAI_FDB_LOG_CRIT("Unable to perform FDB Registered entries tree Init");
         return SAI_STATUS_UNINITIALIZED;
     }
 
-    std_radix_enable_radical(sai_fdb_global_cache.sai_registered_fdb_entry_tree);
-    std_radical_walkconstructor (sai_fdb_global_cache.sai_registered_fdb_entry_tree,
-                                 &(sai_fdb_global_cache.fdb_marker));
-    sai_fdb_global_cache.num_notifications = 0;
-    sai_fdb_global_cache.cur_notification_idx = 0;
+    shard->fdb_port_tree = std_rbtree_create_simple("FDBPortTree",
+                                        STD_STR_OFFSET_OF(sai_fdb_port_node_t, port_id),
+                                        STD_STR_SIZE_OF(sai_fdb_port_node_t, port_id));
+    if(shard->fdb_port_tree == NULL) {
+        SAI_FDB_LOG_CRIT("Unable to perform FDB port tree Init");
+        return SAI_STATUS_UNINITIALIZED;
+    }
+    shard->num_registered_entries = 0;
+    memset(shard->registered_filter, 0, sizeof(shard->registered_filter));
+
+    std_radix_enable_radical(shard->sai_registered_fdb_entry_tree);
+    std_radical_walkconstructor (shard->sai_registered_fdb_entry_tree, &(shard->fdb_marker));
+    shard->num_notifications = 0;
+    memset(&shard->notification_ring, 0, sizeof(shard->notification_ring));
+    std_dll_init(&shard->dampened_list);
+    shard->num_dampened_entries = 0;
     return SAI_STATUS_SUCCESS;
 }
 
-std_rt_table *sai_fdb_cache_get(void)
+sai_status_t sai_init_fdb_tree(void)
 {
-    return sai_fdb_global_cache.sai_global_fdb_tree;
-}
+    sai_status_t sai_rc;
+    uint_t shard_idx;
+    uint_t vlan_id;
 
-std_rt_table *sai_fdb_registered_entry_cache_get(void)
-{
-    return sai_fdb_global_cache.sai_registered_fdb_entry_tree;
+    SAI_FDB_LOG_TRACE("Performing FDB Module Init");
+    for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+        sai_rc = sai_fdb_shard_init(&sai_fdb_global_cache.shards[shard_idx]);
+        if(sai_rc != SAI_STATUS_SUCCESS) {
+            return sai_rc;
+        }
+    }
+
+    sai_fdb_global_cache.fdb_port_learn_tree = std_rbtree_create_simple("FDBPortLearnTree",
+                                        STD_STR_OFFSET_OF(sai_fdb_port_learn_node_t, port_id),
+                                        STD_STR_SIZE_OF(sai_fdb_port_learn_node_t, port_id));
+    if(sai_fdb_global_cache.fdb_port_learn_tree == NULL) {
+        SAI_FDB_LOG_CRIT("Unable to perform FDB port learn tree Init");
+        return SAI_STATUS_UNINITIALIZED;
+    }
+    for (vlan_id = 0; vlan_id <= SAI_MAX_VLAN_TAG_ID; vlan_id++) {
+        std_dll_init(&sai_fdb_global_cache.fdb_vlan_nodes[vlan_id].fdb_list);
+        sai_fdb_global_cache.fdb_vlan_nodes[vlan_id].fdb_count = 0;
+        sai_fdb_global_cache.fdb_vlan_nodes[vlan_id].learn_count = 0;
+    }
+    sai_fdb_global_cache.move_damp_window_ms = 0;
+    sai_fdb_global_cache.move_damp_threshold = 0;
+    return SAI_STATUS_SUCCESS;
 }
+
 sai_fdb_entry_node_t* sai_get_fdb_entry_node(const sai_fdb_entry_t *fdb_entry)
 {
-    sai_fdb_entry_node_t *fdb_entry_node = NULL;
+    sai_fdb_hash_slot_t *slot = NULL;
     sai_fdb_entry_key_t fdb_key;
 
     STD_ASSERT(fdb_entry != NULL);
@@ -102,25 +746,31 @@ sai_fdb_entry_node_t* sai_get_fdb_entry_node(const sai_fdb_entry_t *fdb_entry)
     memcpy(fdb_key.mac_address, fdb_entry->mac_address, sizeof(sai_mac_t));
     fdb_key.vlan_id = fdb_entry->vlan_id;
 
-    fdb_entry_node = (sai_fdb_entry_node_t *)std_radix_getexact(
-                                                        sai_fdb_global_cache.sai_global_fdb_tree,
-                                                        (u_char *)&fdb_key,
-                                                        SAI_FDB_ENTRY_KEY_SIZE);
-    return fdb_entry_node;
+    slot = sai_fdb_hash_slot_find(&sai_fdb_shard_get(fdb_key.vlan_id)->fdb_hash_index,
+                                  sai_fdb_key_pack(&fdb_key));
+    return (slot != NULL) ? slot->fdb_entry_node : NULL;
 }
 
 sai_fdb_registered_node_t* sai_get_fdb_registered_node (const sai_fdb_entry_t *fdb_entry)
 {
     sai_fdb_registered_node_t *fdb_registered_node = NULL;
+    sai_fdb_shard_t *shard = NULL;
     sai_fdb_entry_key_t fdb_key;
 
     STD_ASSERT(fdb_entry != NULL);
+    shard = sai_fdb_shard_get(fdb_entry->vlan_id);
+    if(shard->num_registered_entries == 0) {
+        return NULL;
+    }
     memset(&fdb_key, 0, sizeof(fdb_key));
     memcpy(fdb_key.mac_address, fdb_entry->mac_address, sizeof(sai_mac_t));
     fdb_key.vlan_id = fdb_entry->vlan_id;
+    if(!sai_fdb_registered_filter_may_contain(shard, &fdb_key)) {
+        return NULL;
+    }
 
     fdb_registered_node = (sai_fdb_registered_node_t *)
-                             std_radix_getexact (sai_fdb_global_cache.sai_registered_fdb_entry_tree,
+                             std_radix_getexact (shard->sai_registered_fdb_entry_tree,
                                                 (u_char *)&fdb_key, SAI_FDB_ENTRY_KEY_SIZE);
     return fdb_registered_node;
 }
@@ -139,6 +789,165 @@ sai_status_t sai_fdb_get_port_from_cache(const sai_fdb_entry_t *fdb_entry,
     *port_id = fdb_entry_node->port_id;
     return SAI_STATUS_SUCCESS;
 }
+static uint64_t sai_fdb_time_ms_get(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (((uint64_t)ts.tv_sec * 1000) + (ts.tv_nsec / 1000000));
+}
+
+/*
+ * Queues the pending notification of a registered node. Notifications go on
+ * the ring while it has room and nothing is spilled. Otherwise they are
+ * spilled to the changelist, which holds one pending notification per entry,
+ * so that they are sent after everything on the ring and in order. An entry
+ * has at most one notification on the ring that is not yet sent: later ones
+ * go to the changelist, so that a flapping entry sends its first and last
+ * state per drain instead of every event.
+ */
+static void sai_fdb_registered_node_queue(sai_fdb_shard_t *shard,
+                                          sai_fdb_registered_node_t *fdb_registered_node)
+{
+    sai_fdb_notification_ring_t *ring = &shard->notification_ring;
+    sai_fdb_internal_notification_data_t *data = NULL;
+    uint_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+    if((fdb_registered_node->node_in_ring) &&
+       ((ring->tail - fdb_registered_node->ring_seq) > (ring->tail - head))) {
+        fdb_registered_node->node_in_ring = false;
+    }
+
+    if((!fdb_registered_node->node_in_ring) && (shard->num_notifications == 0) &&
+       ((ring->tail - head) < SAI_FDB_NOTIFICATION_RING_SIZE)) {
+        data = &ring->data[ring->tail & (SAI_FDB_NOTIFICATION_RING_SIZE - 1)];
+        memcpy(data->fdb_entry.mac_address, fdb_registered_node->fdb_key.mac_address,
+               sizeof(sai_mac_t));
+        data->fdb_entry.vlan_id = fdb_registered_node->fdb_key.vlan_id;
+        data->port_id = fdb_registered_node->port_id;
+        data->fdb_event = fdb_registered_node->fdb_event;
+        data->is_flapping = fdb_registered_node->is_flapping;
+        fdb_registered_node->node_in_ring = true;
+        fdb_registered_node->ring_seq = ring->tail;
+        __atomic_store_n(&ring->tail, ring->tail + 1, __ATOMIC_RELEASE);
+        ring->num_enqueued++;
+        return;
+    }
+
+    if(fdb_registered_node->node_in_ring) {
+        ring->num_coalesced++;
+    } else {
+        ring->num_overflows++;
+    }
+    std_radical_appendtochangelist (shard->sai_registered_fdb_entry_tree,
+                                    &fdb_registered_node->fdb_radical_head);
+    if(fdb_registered_node->node_in_cl) {
+        ring->num_drops++;
+    } else {
+        shard->num_notifications++;
+    }
+    fdb_registered_node->node_in_cl = true;
+}
+
+static void sai_fdb_dampened_node_release(sai_fdb_shard_t *shard,
+                                          sai_fdb_registered_node_t *fdb_registered_node)
+{
+    std_dll_remove(&shard->dampened_list, &fdb_registered_node->dampened_link);
+    shard->num_dampened_entries--;
+    fdb_registered_node->is_dampened = false;
+}
+
+/* Sends the final state of the dampened nodes whose window is over, or of all of them */
+static void sai_fdb_dampened_nodes_release(sai_fdb_shard_t *shard, bool release_all)
+{
+    sai_fdb_registered_node_t *fdb_registered_node = NULL;
+    std_dll *link = NULL;
+    std_dll *next_link = NULL;
+    uint64_t now_ms = sai_fdb_time_ms_get();
+    uint64_t next_release_ms = UINT64_MAX;
+
+    for (link = std_dll_getfirst(&shard->dampened_list); link != NULL; link = next_link) {
+        next_link = std_dll_getnext(&shard->dampened_list, link);
+        fdb_registered_node = SAI_FDB_REGISTERED_NODE_FROM_DAMPENED_LINK(link);
+        if((!release_all) && (now_ms < fdb_registered_node->release_time_ms)) {
+            if(fdb_registered_node->release_time_ms < next_release_ms) {
+                next_release_ms = fdb_registered_node->release_time_ms;
+            }
+            continue;
+        }
+        sai_fdb_dampened_node_release(shard, fdb_registered_node);
+        fdb_registered_node->move_count = 0;
+        fdb_registered_node->window_start_ms = now_ms;
+        sai_fdb_registered_node_queue(shard, fdb_registered_node);
+    }
+    shard->next_release_ms = next_release_ms;
+}
+
+/*
+ * Records an event of a registered entry and queues its notification. An
+ * entry that moves more than move_damp_threshold times within a window is
+ * dampened: its events only update the pending state, which is sent once
+ * the window is over.
+ */
+static void sai_fdb_registered_node_notify(sai_fdb_registered_node_t *fdb_registered_node,
+                                           sai_fdb_event_t fdb_event,
+                                           sai_object_id_t port_id)
+{
+    sai_fdb_shard_t *shard = sai_fdb_shard_get(fdb_registered_node->fdb_key.vlan_id);
+    uint_t window_ms = sai_fdb_global_cache.move_damp_window_ms;
+    uint64_t now_ms;
+    bool is_move;
+
+    is_move = ((fdb_event == SAI_FDB_EVENT_LEARNED) &&
+               (fdb_registered_node->port_id != SAI_NULL_OBJECT_ID) &&
+               (fdb_registered_node->port_id != port_id));
+    fdb_registered_node->fdb_event = fdb_event;
+    fdb_registered_node->port_id = port_id;
+
+    if(fdb_registered_node->is_dampened) {
+        shard->notification_ring.num_dampened++;
+        return;
+    }
+    fdb_registered_node->is_flapping = false;
+
+    if((window_ms != 0) && (is_move)) {
+        now_ms = sai_fdb_time_ms_get();
+        if((now_ms - fdb_registered_node->window_start_ms) >= window_ms) {
+            fdb_registered_node->window_start_ms = now_ms;
+            fdb_registered_node->move_count = 0;
+        }
+        fdb_registered_node->move_count++;
+        if(fdb_registered_node->move_count > sai_fdb_global_cache.move_damp_threshold) {
+            fdb_registered_node->is_dampened = true;
+            fdb_registered_node->is_flapping = true;
+            fdb_registered_node->release_time_ms = fdb_registered_node->window_start_ms +
+                                                   window_ms;
+            std_dll_insertatback(&shard->dampened_list, &fdb_registered_node->dampened_link);
+            if((shard->num_dampened_entries == 0) ||
+               (fdb_registered_node->release_time_ms < shard->next_release_ms)) {
+                shard->next_release_ms = fdb_registered_node->release_time_ms;
+            }
+            shard->num_dampened_entries++;
+            shard->notification_ring.num_dampened++;
+            return;
+        }
+    }
+    sai_fdb_registered_node_queue(shard, fdb_registered_node);
+}
+
+void sai_fdb_move_dampening_set (uint_t window_ms, uint_t move_threshold)
+{
+    uint_t shard_idx;
+
+    sai_fdb_global_cache.move_damp_window_ms = window_ms;
+    sai_fdb_global_cache.move_damp_threshold = move_threshold;
+    if(window_ms == 0) {
+        for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+            sai_fdb_dampened_nodes_release(&sai_fdb_global_cache.shards[shard_idx], true);
+        }
+    }
+}
+
 void sai_remove_fdb_entry_node (sai_fdb_entry_node_t *fdb_entry_node)
 {
     sai_fdb_registered_node_t *fdb_registered_node = NULL;
@@ -151,25 +960,164 @@ void sai_remove_fdb_entry_node (sai_fdb_entry_node_t *fdb_entry_node)
 
     fdb_registered_node = sai_get_fdb_registered_node(&fdb_entry);
     if(fdb_registered_node != NULL) {
-        fdb_registered_node->fdb_event = SAI_FDB_EVENT_FLUSHED;
-        std_radical_appendtochangelist (sai_fdb_global_cache.sai_registered_fdb_entry_tree,
-                                        &fdb_registered_node->fdb_radical_head);
-        if(!fdb_registered_node->node_in_cl) {
-            sai_fdb_global_cache.num_notifications++;
+        sai_fdb_registered_node_notify(fdb_registered_node, SAI_FDB_EVENT_FLUSHED,
+                                       fdb_registered_node->port_id);
+    }
+    sai_fdb_entry_learn_count_update(fdb_entry_node, false);
+    sai_fdb_entry_node_unlink(fdb_entry_node);
+    sai_fdb_entry_node_free(sai_fdb_shard_get(fdb_entry.vlan_id), fdb_entry_node);
+}
+
+static bool sai_fdb_flush_entry_match(const sai_fdb_entry_node_t *fdb_entry_node,
+                                      sai_object_id_t port_id, sai_vlan_id_t vlan_id,
+                                      bool delete_all,
+                                      sai_fdb_flush_entry_type_t flush_type)
+{
+    if((port_id != SAI_NULL_OBJECT_ID) && (fdb_entry_node->port_id != port_id)) {
+        return false;
+    }
+    if((vlan_id != VLAN_UNDEF) && (fdb_entry_node->fdb_key.vlan_id != vlan_id)) {
+        return false;
+    }
+    if((!delete_all) &&
+       (fdb_entry_node->entry_type != sai_get_sai_fdb_entry_type_for_flush(flush_type))) {
+        return false;
+    }
+    return true;
+}
+
+/* Removes the matching nodes of a port list, or of a VLAN list if port_list is false */
+static uint_t sai_fdb_flush_entry_list(std_dll_head *fdb_list, bool port_list,
+                                       sai_object_id_t port_id, sai_vlan_id_t vlan_id,
+                                       bool delete_all,
+                                       sai_fdb_flush_entry_type_t flush_type)
+{
+    sai_fdb_entry_node_t *fdb_entry_node = NULL;
+    std_dll *link = NULL;
+    std_dll *next_link = NULL;
+    uint_t flushed_count = 0;
+
+    /* The port list head is freed along with its last node, so never go back to it */
+    for (link = std_dll_getfirst(fdb_list); link != NULL; link = next_link) {
+        next_link = std_dll_getnext(fdb_list, link);
+        fdb_entry_node = port_list ? SAI_FDB_NODE_FROM_PORT_LINK(link) :
+                                     SAI_FDB_NODE_FROM_VLAN_LINK(link);
+        if(sai_fdb_flush_entry_match(fdb_entry_node, port_id, vlan_id,
+                                     delete_all, flush_type)) {
+            sai_remove_fdb_entry_node(fdb_entry_node);
+            flushed_count++;
         }
-        fdb_registered_node->node_in_cl = true;
     }
-    std_radix_remove(sai_fdb_global_cache.sai_global_fdb_tree,&(fdb_entry_node->fdb_rt_head));
-    free(fdb_entry_node);
+    return flushed_count;
+}
+
+sai_status_t sai_fdb_flush_entry_nodes (sai_object_id_t port_id, sai_vlan_id_t vlan_id,
+                                        bool delete_all,
+                                        sai_fdb_flush_entry_type_t flush_type,
+                                        uint_t *flushed_count)
+{
+    sai_fdb_port_node_t *port_node = NULL;
+    sai_fdb_vlan_node_t *vlan_node = NULL;
+    uint_t count = 0;
+    uint_t shard_idx;
+    uint_t vlan_idx;
+
+    if(vlan_id > SAI_MAX_VLAN_TAG_ID) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+    if(vlan_id != VLAN_UNDEF) {
+        vlan_node = &sai_fdb_global_cache.fdb_vlan_nodes[vlan_id];
+    }
+
+    if((port_id != SAI_NULL_OBJECT_ID) && (vlan_node != NULL)) {
+        /* Nothing to flush if nothing is learnt on the port, else walk the shorter list */
+        port_node = sai_fdb_port_node_get(sai_fdb_shard_get(vlan_id), port_id);
+        if((port_node != NULL) && (vlan_node->fdb_count < port_node->fdb_count)) {
+            count = sai_fdb_flush_entry_list(&vlan_node->fdb_list, false, port_id, vlan_id,
+                                             delete_all, flush_type);
+        } else if(port_node != NULL) {
+            count = sai_fdb_flush_entry_list(&port_node->fdb_list, true, port_id, vlan_id,
+                                             delete_all, flush_type);
+        }
+    } else if(port_id != SAI_NULL_OBJECT_ID) {
+        for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+            port_node = sai_fdb_port_node_get(&sai_fdb_global_cache.shards[shard_idx], port_id);
+            if(port_node == NULL) {
+                continue;
+            }
+            count += sai_fdb_flush_entry_list(&port_node->fdb_list, true, port_id, vlan_id,
+                                              delete_all, flush_type);
+        }
+    } else if(vlan_node != NULL) {
+        count = sai_fdb_flush_entry_list(&vlan_node->fdb_list, false, port_id, vlan_id,
+                                         delete_all, flush_type);
+    } else {
+        for (vlan_idx = 0; vlan_idx <= SAI_MAX_VLAN_TAG_ID; vlan_idx++) {
+            if(sai_fdb_global_cache.fdb_vlan_nodes[vlan_idx].fdb_count == 0) {
+                continue;
+            }
+            count += sai_fdb_flush_entry_list(&sai_fdb_global_cache.fdb_vlan_nodes[vlan_idx].fdb_list,
+                                              false, port_id, vlan_id, delete_all, flush_type);
+        }
+    }
+
+    SAI_FDB_LOG_TRACE("Flushed %d FDB entries port:0x%"PRIx64" vlan:%d",
+                      count, port_id, vlan_id);
+    if(flushed_count != NULL) {
+        *flushed_count = count;
+    }
+    return SAI_STATUS_SUCCESS;
+}
+
+/*
+ * Ordered walks merge the trees of the shards. Keys of a VLAN are next to
+ * each other and all in the shard of the VLAN, so the next key in the shard
+ * of the current VLAN is the next key overall if it has the same VLAN. Only
+ * when the walk leaves a VLAN are the other shards looked at.
+ */
+static std_rt_head *sai_fdb_shard_tree_getnext(std_rt_table *(*tree_get)(sai_fdb_shard_t *),
+                                               const sai_fdb_entry_key_t *fdb_key)
+{
+    const sai_fdb_entry_key_t *next_key = NULL;
+    std_rt_head *next_rt_head = NULL;
+    std_rt_head *rt_head = NULL;
+    uint_t shard_idx;
+
+    rt_head = std_radix_getnext(tree_get(sai_fdb_shard_get(fdb_key->vlan_id)),
+                                (u_char *)fdb_key, SAI_FDB_ENTRY_KEY_SIZE);
+    if((rt_head != NULL) &&
+       (((const sai_fdb_entry_key_t *)rt_head->rth_addr)->vlan_id == fdb_key->vlan_id)) {
+        return rt_head;
+    }
+    for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+        rt_head = std_radix_getnext(tree_get(&sai_fdb_global_cache.shards[shard_idx]),
+                                    (u_char *)fdb_key, SAI_FDB_ENTRY_KEY_SIZE);
+        if((rt_head != NULL) &&
+           ((next_key == NULL) ||
+            (memcmp(rt_head->rth_addr, next_key, sizeof(sai_fdb_entry_key_t)) < 0))) {
+            next_rt_head = rt_head;
+            next_key = (const sai_fdb_entry_key_t *)rt_head->rth_addr;
+        }
+    }
+    return next_rt_head;
+}
+
+static std_rt_table *sai_fdb_shard_entry_tree_get(sai_fdb_shard_t *shard)
+{
+    return shard->sai_global_fdb_tree;
+}
+
+static std_rt_table *sai_fdb_shard_registered_tree_get(sai_fdb_shard_t *shard)
+{
+    return shard->sai_registered_fdb_entry_tree;
 }
 
 sai_fdb_entry_node_t *sai_get_next_fdb_entry_node (sai_fdb_entry_key_t *fdb_key)
 {
     sai_fdb_entry_node_t *fdb_entry_node;
 
-    fdb_entry_node = (sai_fdb_entry_node_t *)std_radix_getnext(
-                                                        sai_fdb_global_cache.sai_global_fdb_tree,
-                                                        (u_char *)fdb_key, SAI_FDB_ENTRY_KEY_SIZE);
+    fdb_entry_node = (sai_fdb_entry_node_t *)sai_fdb_shard_tree_getnext(
+                                                        sai_fdb_shard_entry_tree_get, fdb_key);
     return fdb_entry_node;
 }
 
@@ -178,9 +1126,8 @@ sai_fdb_registered_node_t *sai_get_next_fdb_registered_node (sai_fdb_entry_key_t
 {
     sai_fdb_registered_node_t *fdb_registered_node;
 
-    fdb_registered_node = (sai_fdb_registered_node_t *)std_radix_getnext(
-                                                        sai_fdb_global_cache.sai_registered_fdb_entry_tree,
-                                                        (u_char *)fdb_key, SAI_FDB_ENTRY_KEY_SIZE);
+    fdb_registered_node = (sai_fdb_registered_node_t *)sai_fdb_shard_tree_getnext(
+                                                    sai_fdb_shard_registered_tree_get, fdb_key);
     return fdb_registered_node;
 }
 
@@ -188,13 +1135,21 @@ sai_fdb_entry_node_t *sai_add_fdb_entry_node_in_global_tree(sai_fdb_entry_node_t
                                                             *fdb_entry_node)
 {
     sai_fdb_entry_node_t *p_out_fdb_entry_node = NULL;
+    sai_fdb_hash_slot_t *slot = NULL;
+    sai_fdb_shard_t *shard = NULL;
     std_rt_head *fdb_rt_head = NULL;
     char mac_str[SAI_MAC_STR_LEN] = {0};
 
     STD_ASSERT(fdb_entry_node != NULL);
+    shard = sai_fdb_shard_get(fdb_entry_node->fdb_key.vlan_id);
+    slot = sai_fdb_hash_slot_find(&shard->fdb_hash_index,
+                                  sai_fdb_key_pack(&fdb_entry_node->fdb_key));
+    if(slot != NULL) {
+        return slot->fdb_entry_node;
+    }
     fdb_entry_node->fdb_rt_head.rth_addr = (unsigned char *)
                                                  &fdb_entry_node->fdb_key;
-    fdb_rt_head = std_radix_insert (sai_fdb_global_cache.sai_global_fdb_tree,
+    fdb_rt_head = std_radix_insert (shard->sai_global_fdb_tree,
                                     &(fdb_entry_node->fdb_rt_head),
                                     SAI_FDB_ENTRY_KEY_SIZE);
 
@@ -207,38 +1162,38 @@ sai_fdb_entry_node_t *sai_add_fdb_entry_node_in_global_tree(sai_fdb_entry_node_t
     else {
         p_out_fdb_entry_node = (sai_fdb_entry_node_t *)
             ((char *) fdb_rt_head - STD_STR_OFFSET_OF (sai_fdb_entry_node_t, fdb_rt_head));
+        if(p_out_fdb_entry_node == fdb_entry_node) {
+            if(sai_fdb_hash_index_insert(&shard->fdb_hash_index,
+                                         fdb_entry_node) != SAI_STATUS_SUCCESS) {
+                std_radix_remove(shard->sai_global_fdb_tree, &(fdb_entry_node->fdb_rt_head));
+                return NULL;
+            }
+            sai_fdb_entry_vlan_link(fdb_entry_node);
+        }
     }
 
     return p_out_fdb_entry_node;
 }
 
-sai_status_t sai_insert_fdb_entry_node(const sai_fdb_entry_t* fdb_entry,
-                                       sai_fdb_entry_node_t *fdb_entry_node_data)
+static sai_status_t sai_fdb_entry_node_insert(const sai_fdb_entry_t *fdb_entry,
+                                              const sai_fdb_entry_node_t *fdb_entry_node_data,
+                                              sai_fdb_entry_update_t *update)
 {
     sai_fdb_entry_node_t *fdb_entry_node = NULL;
     sai_fdb_entry_node_t *tmp_fdb_entry_node;
     sai_fdb_registered_node_t *fdb_registered_node = NULL;
     bool notify = true;
+    sai_status_t sai_rc;
 
     STD_ASSERT(fdb_entry != NULL);
-    fdb_entry_node = (sai_fdb_entry_node_t *)
-                           calloc(1, sizeof(sai_fdb_entry_node_t));
-    if(fdb_entry_node == NULL) {
-        SAI_FDB_LOG_CRIT("No memory for %d",
-                         sizeof(sai_fdb_entry_node_t));
-        return SAI_STATUS_NO_MEMORY;
+    STD_ASSERT(fdb_entry_node_data != NULL);
+    *update = SAI_FDB_ENTRY_UPDATE_NONE;
+    if(fdb_entry->vlan_id > SAI_MAX_VLAN_TAG_ID) {
+        return SAI_STATUS_INVALID_PARAMETER;
     }
-    fdb_entry_node->fdb_key.vlan_id = fdb_entry->vlan_id;
-    memcpy(fdb_entry_node->fdb_key.mac_address,fdb_entry->mac_address,
-           sizeof(sai_mac_t));
-    tmp_fdb_entry_node = sai_add_fdb_entry_node_in_global_tree (fdb_entry_node);
+    fdb_entry_node = sai_get_fdb_entry_node(fdb_entry);
 
-    if (tmp_fdb_entry_node != fdb_entry_node) {
-        free (fdb_entry_node);
-        if (tmp_fdb_entry_node == NULL) {
-            return SAI_STATUS_FAILURE;
-        }
-        fdb_entry_node = tmp_fdb_entry_node;
+    if(fdb_entry_node != NULL) {
         if((fdb_entry_node->port_id == fdb_entry_node_data->port_id) &&
            (fdb_entry_node->entry_type == fdb_entry_node_data->entry_type) &&
            (fdb_entry_node->action == fdb_entry_node_data->action)) {
@@ -246,30 +1201,138 @@ sai_status_t sai_insert_fdb_entry_node(const sai_fdb_entry_t* fdb_entry,
         }
         if(fdb_entry_node->port_id == fdb_entry_node_data->port_id) {
             notify = false;
+            *update = SAI_FDB_ENTRY_UPDATE_MODIFIED;
+        } else {
+            *update = SAI_FDB_ENTRY_UPDATE_MOVED;
         }
+        sai_fdb_entry_learn_count_update(fdb_entry_node, false);
+    } else {
+        fdb_entry_node = sai_fdb_entry_node_alloc(sai_fdb_shard_get(fdb_entry->vlan_id));
+        if(fdb_entry_node == NULL) {
+            return SAI_STATUS_NO_MEMORY;
+        }
+        fdb_entry_node->fdb_key.vlan_id = fdb_entry->vlan_id;
+        memcpy(fdb_entry_node->fdb_key.mac_address,fdb_entry->mac_address,
+               sizeof(sai_mac_t));
+        tmp_fdb_entry_node = sai_add_fdb_entry_node_in_global_tree (fdb_entry_node);
+        if (tmp_fdb_entry_node != fdb_entry_node) {
+            sai_fdb_entry_node_free (sai_fdb_shard_get(fdb_entry->vlan_id), fdb_entry_node);
+            return SAI_STATUS_FAILURE;
+        }
+        *update = SAI_FDB_ENTRY_UPDATE_NEW;
     }
     if(fdb_entry_node_data->is_pending_entry) {
         notify = false;
     }
+    sai_rc = sai_fdb_entry_port_link(fdb_entry_node, fdb_entry_node_data->port_id);
+    if(sai_rc != SAI_STATUS_SUCCESS) {
+        if(*update == SAI_FDB_ENTRY_UPDATE_NEW) {
+            sai_fdb_entry_node_unlink(fdb_entry_node);
+            sai_fdb_entry_node_free(sai_fdb_shard_get(fdb_entry->vlan_id), fdb_entry_node);
+        } else {
+            sai_fdb_entry_learn_count_update(fdb_entry_node, true);
+        }
+        *update = SAI_FDB_ENTRY_UPDATE_NONE;
+        return sai_rc;
+    }
     fdb_registered_node = sai_get_fdb_registered_node(fdb_entry);
     if((notify) && (fdb_registered_node != NULL)) {
-        fdb_registered_node->fdb_event = SAI_FDB_EVENT_LEARNED;
-        std_radical_appendtochangelist (sai_fdb_global_cache.sai_registered_fdb_entry_tree,
-                                        &fdb_registered_node->fdb_radical_head);
-        fdb_registered_node->port_id = fdb_entry_node_data->port_id;
-        if(!fdb_registered_node->node_in_cl) {
-            sai_fdb_global_cache.num_notifications++;
-        }
-        fdb_registered_node->node_in_cl = true;
+        sai_fdb_registered_node_notify(fdb_registered_node, SAI_FDB_EVENT_LEARNED,
+                                       fdb_entry_node_data->port_id);
     }
-    fdb_entry_node->port_id =fdb_entry_node_data-> port_id;
     fdb_entry_node->entry_type = fdb_entry_node_data->entry_type;
     fdb_entry_node->action = fdb_entry_node_data->action;
     fdb_entry_node->metadata = fdb_entry_node_data->metadata;
     fdb_entry_node->is_pending_entry = fdb_entry_node_data->is_pending_entry;
+    sai_fdb_entry_learn_count_update(fdb_entry_node, true);
     return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t sai_insert_fdb_entry_node(const sai_fdb_entry_t* fdb_entry,
+                                       sai_fdb_entry_node_t *fdb_entry_node_data)
+{
+    sai_fdb_entry_update_t update;
+
+    return sai_fdb_entry_node_insert(fdb_entry, fdb_entry_node_data, &update);
+}
+
+sai_status_t sai_insert_fdb_entry_nodes(uint_t count, const sai_fdb_entry_t *fdb_entries,
+                                        const sai_fdb_entry_node_t *fdb_entry_node_data,
+                                        sai_fdb_entry_update_t *updates,
+                                        sai_status_t *object_statuses)
+{
+    sai_fdb_entry_update_t update;
+    sai_fdb_shard_t *shard = NULL;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint_t new_count[SAI_FDB_NUM_SHARDS];
+    uint_t shard_idx;
+    uint_t entry_idx;
+
+    if((count == 0) || (fdb_entries == NULL) || (fdb_entry_node_data == NULL) ||
+       (object_statuses == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    /* Size the index and the node pool of each shard for the new keys of the burst at once */
+    memset(new_count, 0, sizeof(new_count));
+    for (entry_idx = 0; entry_idx < count; entry_idx++) {
+        if(sai_get_fdb_entry_node(&fdb_entries[entry_idx]) == NULL) {
+            new_count[sai_fdb_shard_idx_get(fdb_entries[entry_idx].vlan_id)]++;
+        }
+    }
+    for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+        if(new_count[shard_idx] == 0) {
+            continue;
+        }
+        shard = &sai_fdb_global_cache.shards[shard_idx];
+        if(sai_fdb_hash_index_reserve(&shard->fdb_hash_index,
+                                      new_count[shard_idx]) != SAI_STATUS_SUCCESS) {
+            SAI_FDB_LOG_WARN("Unable to reserve FDB hash index for %d entries",
+                             new_count[shard_idx]);
+        }
+        if(sai_fdb_node_pool_reserve(shard, new_count[shard_idx]) != SAI_STATUS_SUCCESS) {
+            SAI_FDB_LOG_WARN("Unable to reserve %d FDB entry nodes", new_count[shard_idx]);
+        }
+    }
+
+    for (entry_idx = 0; entry_idx < count; entry_idx++) {
+        object_statuses[entry_idx] = sai_fdb_entry_node_insert(&fdb_entries[entry_idx],
+                                                               &fdb_entry_node_data[entry_idx],
+                                                               &update);
+        if(updates != NULL) {
+            updates[entry_idx] = update;
+        }
+        if((object_statuses[entry_idx] != SAI_STATUS_SUCCESS) &&
+           (object_statuses[entry_idx] != SAI_STATUS_ITEM_ALREADY_EXISTS)) {
+            sai_rc = SAI_STATUS_FAILURE;
+        }
+    }
+    return sai_rc;
+}
+
+sai_status_t sai_remove_fdb_entry_nodes(uint_t count, const sai_fdb_entry_t *fdb_entries,
+                                        sai_status_t *object_statuses)
+{
+    sai_fdb_entry_node_t *fdb_entry_node = NULL;
+    sai_status_t sai_rc = SAI_STATUS_SUCCESS;
+    uint_t entry_idx;
+
+    if((count == 0) || (fdb_entries == NULL) || (object_statuses == NULL)) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+    for (entry_idx = 0; entry_idx < count; entry_idx++) {
+        fdb_entry_node = sai_get_fdb_entry_node(&fdb_entries[entry_idx]);
+        if(fdb_entry_node == NULL) {
+            object_statuses[entry_idx] = SAI_STATUS_ADDR_NOT_FOUND;
+            sai_rc = SAI_STATUS_FAILURE;
+            continue;
+        }
+        sai_remove_fdb_entry_node(fdb_entry_node);
+        object_statuses[entry_idx] = SAI_STATUS_SUCCESS;
+    }
+    return sai_rc;
+}
+
 void sai_fdb_internal_callback_cache_update (sai_fdb_internal_callback_fn
                                                  fdb_callback)
 {
@@ -281,11 +1344,97 @@ void sai_fdb_npu_flush_callback_cache_update (sai_npu_flush_fdb_entry_fn flush_f
    sai_npu_flush_fdb_entry = flush_fdb_entry;
 }
 
+void sai_fdb_learn_limit_callback_cache_update (sai_fdb_learn_limit_callback_fn
+                                                    learn_limit_callback)
+{
+   fdb_learn_limit_callback = learn_limit_callback;
+}
+
+sai_status_t sai_fdb_port_learn_limit_set (sai_object_id_t port_id, uint_t learn_limit)
+{
+    sai_fdb_port_learn_node_t *learn_node = NULL;
+    uint64_t old_state = 0;
+    uint64_t new_state = 0;
+
+    if(sai_fdb_global_cache.fdb_port_learn_tree == NULL) {
+        return SAI_STATUS_UNINITIALIZED;
+    }
+    std_mutex_lock(&fdb_port_learn_lock);
+    if(learn_limit == SAI_FDB_LEARN_LIMIT_DISABLE) {
+        learn_node = sai_fdb_port_learn_node_get(port_id);
+    } else {
+        learn_node = sai_fdb_port_learn_node_get_or_create(port_id);
+        if(learn_node == NULL) {
+            std_mutex_unlock(&fdb_port_learn_lock);
+            return SAI_STATUS_NO_MEMORY;
+        }
+    }
+    if(learn_node != NULL) {
+        old_state = __atomic_load_n(&learn_node->learn_state, __ATOMIC_RELAXED);
+        do {
+            new_state = SAI_FDB_LEARN_STATE(SAI_FDB_LEARN_STATE_COUNT(old_state), learn_limit);
+        } while (!__atomic_compare_exchange_n(&learn_node->learn_state, &old_state, new_state,
+                                              true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+        sai_fdb_port_learn_node_release(learn_node);
+    }
+    std_mutex_unlock(&fdb_port_learn_lock);
+    sai_fdb_learn_limit_notify(port_id, VLAN_UNDEF,
+                               SAI_FDB_LEARN_STATE_COUNT(old_state),
+                               SAI_FDB_LEARN_STATE_LIMIT(old_state),
+                               SAI_FDB_LEARN_STATE_COUNT(new_state),
+                               SAI_FDB_LEARN_STATE_LIMIT(new_state));
+    return SAI_STATUS_SUCCESS;
+}
+
+sai_status_t sai_fdb_vlan_learn_limit_set (sai_vlan_id_t vlan_id, uint_t learn_limit)
+{
+    sai_fdb_vlan_node_t *vlan_node = NULL;
+    uint_t old_limit;
+
+    if(vlan_id > SAI_MAX_VLAN_TAG_ID) {
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+    vlan_node = &sai_fdb_global_cache.fdb_vlan_nodes[vlan_id];
+    old_limit = vlan_node->learn_limit;
+    vlan_node->learn_limit = learn_limit;
+    sai_fdb_learn_limit_notify(SAI_NULL_OBJECT_ID, vlan_id, vlan_node->learn_count, old_limit,
+                               vlan_node->learn_count, learn_limit);
+    return SAI_STATUS_SUCCESS;
+}
+
+uint_t sai_fdb_port_learn_count_get (sai_object_id_t port_id)
+{
+    sai_fdb_port_learn_node_t *learn_node = NULL;
+    uint_t learn_count = 0;
+
+    if(sai_fdb_global_cache.fdb_port_learn_tree == NULL) {
+        return 0;
+    }
+    std_mutex_lock(&fdb_port_learn_lock);
+    learn_node = sai_fdb_port_learn_node_get(port_id);
+    if(learn_node != NULL) {
+        learn_count = SAI_FDB_LEARN_STATE_COUNT(__atomic_load_n(&learn_node->learn_state,
+                                                                __ATOMIC_RELAXED));
+    }
+    std_mutex_unlock(&fdb_port_learn_lock);
+    return learn_count;
+}
+
+uint_t sai_fdb_vlan_learn_count_get (sai_vlan_id_t vlan_id)
+{
+    if(vlan_id > SAI_MAX_VLAN_TAG_ID) {
+        return 0;
+    }
+    return sai_fdb_global_cache.fdb_vlan_nodes[vlan_id].learn_count;
+}
+
 int sai_fdb_notification_list_walk(std_radical_head_t *radical_head, va_list ap)
 {
    sai_fdb_registered_node_t *fdb_registered_node = (sai_fdb_registered_node_t *)radical_head;
    char                  mac_str[SAI_MAC_STR_LEN] = {0};
    sai_fdb_internal_notification_data_t *data = NULL;
+   sai_fdb_shard_t *shard = NULL;
+   uint_t *num_data = NULL;
 
    SAI_FDB_LOG_INFO ("FDB Node MAC:%s vlan:%d Event:%d port:0x%"PRIx64"\r\n",
                      std_mac_to_string((const sai_mac_t*)
@@ -294,63 +1443,178 @@ int sai_fdb_notification_list_walk(std_radical_head_t *radical_head, va_list ap)
                      fdb_registered_node->fdb_event, fdb_registered_node->port_id);
 
    data = va_arg(ap,sai_fdb_internal_notification_data_t *);
+   num_data = va_arg(ap,uint_t *);
+   shard = va_arg(ap,sai_fdb_shard_t *);
+
+   fdb_registered_node->node_in_cl = false;
+   shard->num_notifications--;
+   /* Held until the node is released from dampening, which queues it again */
+   if(fdb_registered_node->is_dampened) {
+       return 0;
+   }
 
-   memcpy(data[sai_fdb_global_cache.cur_notification_idx].fdb_entry.mac_address,
+   memcpy(data[*num_data].fdb_entry.mac_address,
           fdb_registered_node->fdb_key.mac_address, sizeof(sai_mac_t));
 
 
-   data[sai_fdb_global_cache.cur_notification_idx].fdb_entry.vlan_id
-                                  = fdb_registered_node->fdb_key.vlan_id;
-   data[sai_fdb_global_cache.cur_notification_idx].port_id = fdb_registered_node->port_id;
-   data[sai_fdb_global_cache.cur_notification_idx].fdb_event = fdb_registered_node->fdb_event;
-   fdb_registered_node->node_in_cl = false;
-   sai_fdb_global_cache.cur_notification_idx++;
-   sai_fdb_global_cache.num_notifications--;
+   data[*num_data].fdb_entry.vlan_id = fdb_registered_node->fdb_key.vlan_id;
+   data[*num_data].port_id = fdb_registered_node->port_id;
+   data[*num_data].fdb_event = fdb_registered_node->fdb_event;
+   data[*num_data].is_flapping = fdb_registered_node->is_flapping;
+   (*num_data)++;
    return 0;
 }
 
 bool sai_fdb_is_notifications_pending (void)
 {
-    if (sai_fdb_global_cache.num_notifications > 0) {
-        return true;
+    sai_fdb_notification_ring_t *ring = NULL;
+    sai_fdb_shard_t *shard = NULL;
+    uint_t shard_idx;
+
+    for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+        shard = &sai_fdb_global_cache.shards[shard_idx];
+        ring = &shard->notification_ring;
+        if ((__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) !=
+             __atomic_load_n(&ring->head, __ATOMIC_RELAXED)) ||
+            (shard->num_notifications > 0)) {
+            return true;
+        }
+        if ((shard->num_dampened_entries > 0) &&
+            (sai_fdb_time_ms_get() >= shard->next_release_ms)) {
+            return true;
+        }
     }
     return false;
 }
 
-void sai_fdb_send_internal_notifications(void)
+bool sai_fdb_notification_next_release_get (uint_t *timeout_ms)
 {
-    int ret;
-    sai_fdb_internal_notification_data_t *data = NULL;
+    sai_fdb_shard_t *shard = NULL;
+    uint64_t next_release_ms = UINT64_MAX;
+    uint64_t release_ms;
+    uint64_t now_ms;
+    uint_t shard_idx;
+
+    STD_ASSERT(timeout_ms != NULL);
+    for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+        shard = &sai_fdb_global_cache.shards[shard_idx];
+        if (__atomic_load_n(&shard->num_dampened_entries, __ATOMIC_RELAXED) == 0) {
+            continue;
+        }
+        release_ms = __atomic_load_n(&shard->next_release_ms, __ATOMIC_RELAXED);
+        if (release_ms < next_release_ms) {
+            next_release_ms = release_ms;
+        }
+    }
+    if (next_release_ms == UINT64_MAX) {
+        *timeout_ms = 0;
+        return false;
+    }
+    now_ms = sai_fdb_time_ms_get();
+    if (next_release_ms <= now_ms) {
+        *timeout_ms = 0;
+    } else if ((next_release_ms - now_ms) > UINT_MAX) {
+        *timeout_ms = UINT_MAX;
+    } else {
+        *timeout_ms = (uint_t)(next_release_ms - now_ms);
+    }
+    return true;
+}
+
+static void sai_fdb_shard_notifications_send(sai_fdb_shard_t *shard)
+{
+    sai_fdb_notification_ring_t *ring = &shard->notification_ring;
+    uint_t head = ring->head;
     uint_t num_notifications = 0;
+    uint_t num_spilled;
+    uint_t slot_idx;
+    int ret;
 
-    if(fdb_internal_callback == NULL) {
-        return;
+    if(shard->num_dampened_entries > 0) {
+        std_mutex_lock(&shard->lock);
+        sai_fdb_dampened_nodes_release(shard, false);
+        std_mutex_unlock(&shard->lock);
     }
 
-    while (sai_fdb_global_cache.num_notifications > 0) {
-        sai_fdb_lock();
+    while (true) {
+        /* Ring first: anything on the changelist was queued after it. The callback
+           gets the ring slots themselves, which are only reused once it returns. */
+        while ((num_notifications = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) - head) > 0) {
+            slot_idx = head & (SAI_FDB_NOTIFICATION_RING_SIZE - 1);
+            if(num_notifications > SAI_FDB_MAX_NOTIFICATION_NODES) {
+                num_notifications = SAI_FDB_MAX_NOTIFICATION_NODES;
+            }
+            if(num_notifications > (SAI_FDB_NOTIFICATION_RING_SIZE - slot_idx)) {
+                num_notifications = SAI_FDB_NOTIFICATION_RING_SIZE - slot_idx;
+            }
+            fdb_internal_callback (num_notifications, &ring->data[slot_idx]);
+            head += num_notifications;
+            __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+        }
 
-        if(sai_fdb_global_cache.num_notifications < SAI_FDB_MAX_NOTIFICATION_NODES) {
-            num_notifications = sai_fdb_global_cache.num_notifications;
-        } else {
-            num_notifications = SAI_FDB_MAX_NOTIFICATION_NODES;
+        std_mutex_lock(&shard->lock);
+        /* The ring is only filled under the lock, so once it is seen empty here
+           nothing on the changelist can be older than a notification on the ring */
+        if(__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) != head) {
+            std_mutex_unlock(&shard->lock);
+            continue;
         }
-        data = calloc(num_notifications, sizeof(sai_fdb_internal_notification_data_t));
-        if (data == NULL) {
-            SAI_FDB_LOG_CRIT ("Error- No memory to allocate for walk");
-            return;
+        if(shard->num_notifications == 0) {
+            std_mutex_unlock(&shard->lock);
+            break;
         }
-        std_radical_walkchangelist (sai_fdb_global_cache.sai_registered_fdb_entry_tree,
-                                    &sai_fdb_global_cache.fdb_marker,
+        num_spilled = shard->num_notifications;
+        num_notifications = 0;
+        std_radical_walkchangelist (shard->sai_registered_fdb_entry_tree,
+                                    &shard->fdb_marker,
                                     sai_fdb_notification_list_walk, 0,
                                     SAI_FDB_MAX_NOTIFICATION_NODES,
-                                    std_radix_getversion(sai_fdb_global_cache.
-                                    sai_registered_fdb_entry_tree),&ret, data);
+                                    std_radix_getversion(shard->sai_registered_fdb_entry_tree),
+                                    &ret, sai_fdb_global_cache.notification_batch,
+                                    &num_notifications, shard);
+        num_spilled -= shard->num_notifications;
+        std_mutex_unlock(&shard->lock);
+        if(num_spilled == 0) {
+            break;
+        }
+        if(num_notifications > 0) {
+            fdb_internal_callback (num_notifications, sai_fdb_global_cache.notification_batch);
+        }
+    }
+}
 
-        sai_fdb_unlock();
-        fdb_internal_callback (sai_fdb_global_cache.cur_notification_idx, data);
-        free(data);
-        sai_fdb_global_cache.cur_notification_idx = 0;
+void sai_fdb_send_internal_notifications(void)
+{
+    uint_t shard_idx;
+
+    if(fdb_internal_callback == NULL) {
+        return;
+    }
+    for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+        sai_fdb_shard_notifications_send(&sai_fdb_global_cache.shards[shard_idx]);
+    }
+}
+
+void sai_fdb_notification_stats_get (sai_fdb_notification_stats_t *stats)
+{
+    sai_fdb_notification_ring_t *ring = NULL;
+    sai_fdb_shard_t *shard = NULL;
+    uint_t shard_idx;
+
+    STD_ASSERT(stats != NULL);
+    memset(stats, 0, sizeof(sai_fdb_notification_stats_t));
+    for (shard_idx = 0; shard_idx < SAI_FDB_NUM_SHARDS; shard_idx++) {
+        shard = &sai_fdb_global_cache.shards[shard_idx];
+        ring = &shard->notification_ring;
+        stats->queue_depth += ring->tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        stats->queue_size += SAI_FDB_NOTIFICATION_RING_SIZE;
+        stats->num_spilled += shard->num_notifications;
+        stats->num_enqueued += ring->num_enqueued;
+        stats->num_overflows += ring->num_overflows;
+        stats->num_coalesced += ring->num_coalesced;
+        stats->num_drops += ring->num_drops;
+        stats->num_dampened += ring->num_dampened;
+        stats->num_dampened_entries += shard->num_dampened_entries;
     }
 }
 
@@ -360,8 +1624,10 @@ sai_status_t sai_fdb_write_registered_entry_into_cache (const sai_fdb_entry_t *f
     std_rt_head *fdb_rt_head = NULL;
     char mac_str[SAI_MAC_STR_LEN] = {0};
     sai_fdb_entry_node_t  *fdb_entry_node = sai_get_fdb_entry_node(fdb_entry);
+    sai_fdb_shard_t *shard = NULL;
 
     STD_ASSERT(fdb_entry != NULL);
+    shard = sai_fdb_shard_get(fdb_entry->vlan_id);
     fdb_registered_node = (sai_fdb_registered_node_t *)
                            calloc(1, sizeof(sai_fdb_registered_node_t));
 
@@ -379,7 +1645,7 @@ sai_status_t sai_fdb_write_registered_entry_into_cache (const sai_fdb_entry_t *f
     }
     fdb_registered_node->fdb_radical_head.rth_addr = (unsigned char *)
                                                    &fdb_registered_node->fdb_key;
-    fdb_rt_head = std_radix_insert (sai_fdb_global_cache.sai_registered_fdb_entry_tree,
+    fdb_rt_head = std_radix_insert (shard->sai_registered_fdb_entry_tree,
                                     (std_rt_head *)&(fdb_registered_node->fdb_radical_head),
                                     SAI_FDB_ENTRY_KEY_SIZE);
 
@@ -395,6 +1661,9 @@ sai_status_t sai_fdb_write_registered_entry_into_cache (const sai_fdb_entry_t *f
         if(fdb_rt_head != (std_rt_head *)&(fdb_registered_node->fdb_radical_head)) {
             SAI_FDB_LOG_INFO ("Duplicate add to the tree");
             free(fdb_registered_node);
+        } else {
+            shard->num_registered_entries++;
+            sai_fdb_registered_filter_update(shard, &fdb_registered_node->fdb_key, true);
         }
     }
 
@@ -405,9 +1674,11 @@ sai_status_t sai_fdb_write_registered_entry_into_cache (const sai_fdb_entry_t *f
 sai_status_t sai_fdb_remove_registered_entry_from_cache (const sai_fdb_entry_t *fdb_entry)
 {
     sai_fdb_registered_node_t *fdb_registered_node = NULL;
+    sai_fdb_shard_t *shard = NULL;
     char mac_str[SAI_MAC_STR_LEN] = {0};
 
     STD_ASSERT(fdb_entry != NULL);
+    shard = sai_fdb_shard_get(fdb_entry->vlan_id);
 
     fdb_registered_node = sai_get_fdb_registered_node (fdb_entry);
     if(fdb_registered_node == NULL) {
@@ -420,9 +1691,14 @@ sai_status_t sai_fdb_remove_registered_entry_from_cache (const sai_fdb_entry_t *
         SAI_FDB_LOG_WARN("Warning object is in CL");
         return SAI_STATUS_OBJECT_IN_USE;
     }
-    std_radix_remove (sai_fdb_global_cache.sai_registered_fdb_entry_tree,
+    if(fdb_registered_node->is_dampened) {
+        sai_fdb_dampened_node_release(shard, fdb_registered_node);
+    }
+    std_radix_remove (shard->sai_registered_fdb_entry_tree,
                       (std_rt_head *)&(fdb_registered_node->fdb_radical_head));
+    sai_fdb_registered_filter_update(shard, &fdb_registered_node->fdb_key, false);
     free(fdb_registered_node);
+    shard->num_registered_entries--;
     return SAI_STATUS_SUCCESS;
 
 }
@@ -432,31 +1708,35 @@ void sai_update_fdb_entry_node (sai_fdb_entry_node_t *fdb_entry_node,
 {
     sai_fdb_registered_node_t *fdb_registered_node = NULL;
     sai_fdb_entry_t fdb_entry;
+    sai_status_t sai_rc;
 
     STD_ASSERT(fdb_entry_node != NULL);
     STD_ASSERT(attr != NULL);
     if(attr->id == SAI_FDB_ENTRY_ATTR_PORT_ID) {
         if(fdb_entry_node->port_id != attr->value.oid) {
-            fdb_entry_node->port_id = attr->value.oid;
+            sai_fdb_entry_learn_count_update(fdb_entry_node, false);
+            sai_rc = sai_fdb_entry_port_link(fdb_entry_node, attr->value.oid);
+            sai_fdb_entry_learn_count_update(fdb_entry_node, true);
+            if(sai_rc != SAI_STATUS_SUCCESS) {
+                SAI_FDB_LOG_CRIT("Unable to move FDB entry to port 0x%"PRIx64"",
+                                 attr->value.oid);
+                return;
+            }
             fdb_entry.vlan_id = fdb_entry_node->fdb_key.vlan_id;
             memcpy(fdb_entry.mac_address, fdb_entry_node->fdb_key.mac_address,
                     sizeof(sai_mac_t));
             fdb_registered_node = sai_get_fdb_registered_node((const sai_fdb_entry_t *)
                                                                   &fdb_entry);
             if(fdb_registered_node != NULL) {
-                fdb_registered_node->fdb_event = SAI_FDB_EVENT_LEARNED;
-                fdb_registered_node->port_id = attr->value.oid;
-                std_radical_appendtochangelist (sai_fdb_global_cache.sai_registered_fdb_entry_tree,
-                                                &fdb_registered_node->fdb_radical_head);
-                if(!fdb_registered_node->node_in_cl) {
-                    sai_fdb_global_cache.num_notifications++;
-                }
-                fdb_registered_node->node_in_cl = true;
+                sai_fdb_registered_node_notify(fdb_registered_node, SAI_FDB_EVENT_LEARNED,
+                                               attr->value.oid);
             }
         }
 
     } else if(attr->id == SAI_FDB_ENTRY_ATTR_TYPE) {
+        sai_fdb_entry_learn_count_update(fdb_entry_node, false);
         fdb_entry_node->entry_type = (sai_fdb_entry_type_t)attr->value.s32;
+        sai_fdb_entry_learn_count_update(fdb_entry_node, true);
     } else if(attr->id == SAI_FDB_ENTRY_ATTR_PACKET_ACTION) {
         fdb_entry_node->action = (sai_packet_action_t)attr->value.s32;
     } else if (attr->id == SAI_FDB_ENTRY_ATTR_META_DATA) {
@@ -31,6 +31,7 @@
 #include "sai_gen_utils.h"
 #include "sai_lag_api.h"
 #include "sai_oid_utils.h"
+#include "sai_ref_count.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -96,25 +97,24 @@ sai_lag_node_t* sai_lag_node_get(sai_object_id_t lag_id)
     return NULL;
 }
 
-sai_status_t sai_lag_increment_ref_count(sai_object_id_t lag_id)
+static bool sai_lag_is_ref_count_obj_valid (sai_object_id_t lag_id)
 {
-    sai_lag_node_t *lag_node = sai_lag_node_get(lag_id);
+    return (sai_lag_node_get(lag_id) != NULL);
+}
 
-    if(lag_node == NULL) {
+sai_status_t sai_lag_increment_ref_count(sai_object_id_t lag_id)
+{
+    if(sai_ref_count_increment (lag_id, sai_lag_is_ref_count_obj_valid) != SAI_STATUS_SUCCESS) {
         return SAI_STATUS_FAILURE;
     }
-    lag_node->ref_count++;
     return SAI_STATUS_SUCCESS;
 }
 
 sai_status_t sai_lag_decrement_ref_count(sai_object_id_t lag_id)
 {
-    sai_lag_node_t *lag_node = sai_lag_node_get(lag_id);
-
-    if((lag_node == NULL) ||(lag_node->ref_count == 0)) {
+    if(sai_ref_count_decrement (lag_id) != SAI_STATUS_SUCCESS) {
         return SAI_STATUS_FAILURE;
     }
-    lag_node->ref_count--;
     return SAI_STATUS_SUCCESS;
 }
 
@@ -143,15 +143,7 @@ sai_status_t sai_lag_def_bridge_port_get(sai_object_id_t lag_id, sai_object_id_t
 
 bool sai_is_lag_in_use (sai_object_id_t lag_id)
 {
-    sai_lag_node_t *lag_node = sai_lag_node_get(lag_id);
-
-    if(lag_node == NULL) {
-        return false;
-    }
-    if(lag_node->ref_count > 0) {
-        return true;
-    }
-    return false;
+    return sai_ref_count_is_in_use (lag_id);
 }
 
 sai_lag_node_t* sai_lag_get_first_node (void)
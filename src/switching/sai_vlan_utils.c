@@ -36,6 +36,7 @@
 #include "sai_port_utils.h"
 #include "sai_oid_utils.h"
 #include "sai_gen_utils.h"
+#include "sai_fdb_api.h"
 
 static sai_vlan_global_cache_node_t *global_vlan_list[SAI_MAX_VLAN_TAG_ID+1];
 static std_mutex_lock_create_static_init_fast(vlan_lock);
@@ -466,6 +467,9 @@ bool sai_vlan_learn_disable_cache_read(sai_vlan_id_t vlan_id)
 void sai_vlan_max_learn_adddress_cache_write(sai_vlan_id_t vlan_id, unsigned int val)
 {
     global_vlan_list[vlan_id]->max_learned_address = val;
+    sai_fdb_shard_lock(vlan_id);
+    sai_fdb_vlan_learn_limit_set(vlan_id, val);
+    sai_fdb_shard_unlock(vlan_id);
 }
 
 unsigned int sai_vlan_max_learn_adddress_cache_read(sai_vlan_id_t vlan_id)
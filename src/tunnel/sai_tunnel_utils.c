@@ -25,10 +25,12 @@
 #include "sai_tunnel_util.h"
 #include "sai_l3_common.h"
 #include "sai_oid_utils.h"
+#include "sai_ref_count.h"
 #include "sai_map_utl.h"
 #include "std_assert.h"
 #include "std_mutex_lock.h"
 #include <string.h>
+#include <stdlib.h>
 #include <inttypes.h>
 
 /* Simple Mutex lock for accessing Tunnel resources */
@@ -132,44 +134,30 @@ sai_status_t sai_tunnel_object_id_validate (sai_object_id_t tunnel_id)
     return status;
 }
 
-sai_status_t sai_tunnel_increment_ref_count (sai_object_id_t tunnel_id)
+static bool sai_tunnel_is_ref_count_obj_valid (sai_object_id_t tunnel_id)
 {
-    dn_sai_tunnel_t *tunnel_obj = dn_sai_tunnel_obj_get(tunnel_id);
+    return (dn_sai_tunnel_obj_get(tunnel_id) != NULL);
+}
 
-    if(tunnel_obj == NULL) {
-        return SAI_STATUS_ITEM_NOT_FOUND;
-    }
-    tunnel_obj->ref_count++;
-    return SAI_STATUS_SUCCESS;
+sai_status_t sai_tunnel_increment_ref_count (sai_object_id_t tunnel_id)
+{
+    return sai_ref_count_increment (tunnel_id, sai_tunnel_is_ref_count_obj_valid);
 }
 
 sai_status_t sai_tunnel_decrement_ref_count (sai_object_id_t tunnel_id)
 {
-    dn_sai_tunnel_t *tunnel_obj = dn_sai_tunnel_obj_get(tunnel_id);
+    sai_status_t sai_rc = sai_ref_count_decrement (tunnel_id);
 
-    if(tunnel_obj == NULL) {
-        return SAI_STATUS_ITEM_NOT_FOUND;
-    }
-    if(tunnel_obj->ref_count == 0) {
+    if((sai_rc == SAI_STATUS_ITEM_NOT_FOUND) && sai_tunnel_is_ref_count_obj_valid (tunnel_id)) {
         return SAI_STATUS_FAILURE;
     }
-    tunnel_obj->ref_count--;
-    return SAI_STATUS_SUCCESS;
+    return sai_rc;
 }
 
 
 bool sai_is_tunnel_in_use (sai_object_id_t tunnel_id)
 {
-    dn_sai_tunnel_t *tunnel_obj = dn_sai_tunnel_obj_get(tunnel_id);
-
-    if(tunnel_obj == NULL) {
-        return false;
-    }
-
-    if(tunnel_obj->ref_count > 0) {
-        return true;
-    }
-    return false;
+    return sai_ref_count_is_in_use (tunnel_id);
 }
 
 dn_sai_tunnel_map_t *dn_sai_tunnel_map_get (sai_object_id_t tunnel_map_id)
@@ -466,44 +454,26 @@ sai_status_t dn_sai_tunnel_map_dep_tunnel_get (sai_object_id_t  tunnel_map_id,
                                                sai_object_id_t *tunnel_id_list)
 {
     sai_map_key_t  key;
-    sai_map_val_t  value;
     sai_status_t   rc;
-    uint_t       index;
 
     if((count == NULL) || (tunnel_id_list == NULL)) {
         SAI_TUNNEL_LOG_ERR ("Invalid inputs given for getting tunnels from "
                             "tunnel map 0x%"PRIx64"",tunnel_map_id);
         return SAI_STATUS_INVALID_PARAMETER;
     }
-    sai_map_data_t data [*count];
-
     memset (&key, 0, sizeof (key));
-    memset (&value, 0, sizeof (value));
-    memset (&data [0], 0, (*count) * sizeof (sai_map_data_t));
 
     key.type = SAI_MAP_TYPE_TUNNEL_MAP_TO_TUNNEL_LIST;
     key.id1  = tunnel_map_id;
 
-    value.count = *count;
-    value.data  = data;
-
-    rc = sai_map_get (&key, &value);
+    rc = sai_map_get_val1_list (&key, count, tunnel_id_list);
 
     if(rc == SAI_STATUS_ITEM_NOT_FOUND) {
         *count = 0;
         return SAI_STATUS_SUCCESS;
     }
 
-    if (rc != SAI_STATUS_SUCCESS) {
-        return rc;
-    }
-
-    for (index = 0; index < value.count; index++) {
-        tunnel_id_list [index] = data [index].val1;
-    }
-    *count = value.count;
-
-    return SAI_STATUS_SUCCESS;
+    return rc;
 }
 
 sai_status_t dn_sai_tunnel_map_dep_tunnel_count_get(sai_object_id_t  tunnel_map_id,
@@ -564,3 +534,41 @@ sai_status_t dn_sai_tunnel_map_dep_tunnel_get_at_index (sai_object_id_t  tunnel_
     *tunnel_id = data.val1;
     return SAI_STATUS_SUCCESS;
 }
+
+sai_status_t dn_sai_tunnel_dep_tunnel_map_get (sai_object_id_t  tunnel_id,
+                                               uint_t          *count,
+                                               sai_object_id_t *tunnel_map_list)
+{
+    sai_map_key_t *key_list;
+    sai_status_t   rc;
+    uint_t         index;
+
+    if((count == NULL) || (tunnel_map_list == NULL)) {
+        SAI_TUNNEL_LOG_ERR ("Invalid inputs given for getting tunnel maps of "
+                            "tunnel 0x%"PRIx64"",tunnel_id);
+        return SAI_STATUS_INVALID_PARAMETER;
+    }
+
+    key_list = (sai_map_key_t *) calloc ((*count > 0) ? *count : 1, sizeof (sai_map_key_t));
+
+    if (key_list == NULL) {
+        return SAI_STATUS_NO_MEMORY;
+    }
+
+    rc = sai_map_reverse_lookup (SAI_MAP_TYPE_TUNNEL_MAP_TO_TUNNEL_LIST, tunnel_id,
+                                 count, key_list);
+
+    if(rc == SAI_STATUS_ITEM_NOT_FOUND) {
+        *count = 0;
+        rc = SAI_STATUS_SUCCESS;
+    }
+    else if (rc == SAI_STATUS_SUCCESS) {
+        for (index = 0; index < *count; index++) {
+            tunnel_map_list [index] = key_list [index].id1;
+        }
+    }
+
+    free (key_list);
+
+    return rc;
+}